@@ -11,6 +11,39 @@ colcon build --packages-select cpp_pubsub
 ros2 run cpp_pubsub cpp_publisher
 # run the subscriber
 ros2 run cpp_pubsub cpp_subscriber
+# real-time mode for the 1 kHz publishers (mlockall, pre-fault, SCHED_FIFO, CPU affinity);
+# without privileges the node warns and runs degraded
+ros2 run cpp_pubsub talker --ros-args -p realtime.enabled:=true -p realtime.priority:=80 -p realtime.cpu_affinity:=2
+ros2 run cpp_pubsub talker_new_intf --ros-args -p realtime.enabled:=true
+# pool allocator opt-in (talker/listener, *_new_intf, address book nodes), counters logged every second
+ros2 run cpp_pubsub listener --ros-args -p memory.pool:=true -p memory.stats_period_ms:=1000
+colcon test --packages-select tutorial_utils && colcon test-result --verbose
+# performance regression gate (ctest label perf): talker build, listener dispatch, AddTwoInts, Fibonacci loop
+# compared with each package's test/perf_baseline.json, keyed on CPU model + count (or PERF_GATE_HOST);
+# opt-in (-DPERF_GATE=ON); fails when this host has no baseline: record one first
+colcon build --packages-select cpp_pubsub cpp_srvcli action_tutorials_cpp --cmake-args -DPERF_GATE=ON
+PERF_GATE_UPDATE=1 colcon test --packages-select cpp_pubsub cpp_srvcli action_tutorials_cpp --ctest-args -L perf
+colcon test --packages-select cpp_pubsub cpp_srvcli action_tutorials_cpp --ctest-args -L perf && colcon test-result --verbose
+# per-publisher loss / reorder / duplicate counters and loss-rate histogram (listener, listener_new_intf)
+ros2 run cpp_pubsub listener --ros-args -p sequence.window_ms:=1000
+ros2 topic echo /diagnostics
+# worst-case timer period before/after real-time mode
+ros2 run cpp_pubsub timer_jitter_benchmark --ros-args -p samples:=5000 -p realtime.priority:=80 -p realtime.cpu_affinity:=1
+# talker message built in place (only the "<ts> <count>" suffix rewritten with to_chars); build cost per size
+ros2 run cpp_pubsub talker --ros-args -p message.build_mode:=in_place
+ros2 run cpp_pubsub payload_build_benchmark 200
+# adaptive publish rate: throttled listener reports age/loss every window, talker backs off (AIMD)
+ros2 run cpp_pubsub listener --ros-args -p sequence.window_ms:=100 -p throttle.work_us:=3000
+ros2 run cpp_pubsub talker --ros-args -p adaptive.enabled:=true -p adaptive.target_age_ms:=10
+ros2 topic echo /chatter/rate_feedback
+# scaling: N talkers x M listeners (shared topic or disjoint topics) -> RSS per entity, discovery, CPU/msg, latency
+ros2 run cpp_pubsub scaling_harness --ros-args -p talkers:=100 -p listeners:=100 -p topology:=shared -p duration_s:=10
+ros2 launch cpp_pubsub scaling_launch.py talkers:=200 listeners:=200 processes:=4 topology:=disjoint
+ros2 run cpp_pubsub scaling_sweep.sh "1 10 50 100 200" 5 scaling.csv
+# batched Num: talker_new_intf coalesces values into NumArray frames on /topic/batch, listener unpacks them
+ros2 run cpp_pubsub talker_new_intf --ros-args -p batch.max_items:=32 -p batch.max_delay_us:=5000
+ros2 run cpp_pubsub listener_new_intf --ros-args -p batch.enabled:=true
+ros2 run cpp_pubsub batch_benchmark --ros-args -p rate_hz:=10000.0 -p batch_sizes:="[0, 1, 4, 16, 64, 128]"
 
 # 2 Writing a simple publisher and subscriber (Python)
 ros2 pkg create --build-type ament_python py_pubsub --dependencies rclpy std_msgs
@@ -39,6 +72,21 @@ colcon build --packages-select cpp_srvcli
 . install/setup.bash
 # run the service
 ros2 run cpp_srvcli cpp_service
+# startup phase timestamps (any C++ tutorial executable), printed once at the first message/response
+TUTORIAL_STARTUP_PROFILE=1 ros2 run cpp_srvcli client_new_intf 1 2 3
+# server + client pre-created in one component container, optional localhost discovery profile
+ros2 launch cpp_srvcli fast_start_launch.py fast_discovery:=true
+# time to first response / first message: separate processes vs container, default vs localhost discovery
+ros2 run cpp_srvcli startup_benchmark.sh 10
+# several services on one node with a shared worker pool; per-service metrics on /diagnostics
+ros2 run cpp_srvcli multiplexed_server --ros-args -p workers:=8 -p multiply_two_ints.delay_ms:=50 -p multiply_two_ints.max_concurrency:=2
+# aggregate requests/second with 1..64 client threads (compare against cpp_service)
+ros2 run cpp_srvcli service_load_benchmark --ros-args -p service:=add_two_ints -p threads:="1,2,4,8,16,32,64"
+# per-hop request/response timestamps (client queue, transport, dispatch, handler), analyzed offline
+mkdir -p /tmp/srvtrace
+SRVCLI_TRACE_DIR=/tmp/srvtrace ros2 run cpp_srvcli cpp_service
+SRVCLI_TRACE_DIR=/tmp/srvtrace ros2 run cpp_srvcli cpp_client
+ros2 run cpp_srvcli service_trace_analyzer /tmp/srvtrace
 
 # 4 Writing a simple service and client (Python)
 # Recall that packages should be created in the src directory, not the root of the workspace. Navigate into ros2_ws/src and create a new package:
@@ -76,6 +124,19 @@ mkdir more_interfaces/msg more_interfaces/srv
 colcon build --packages-up-to more_interfaces
 source install/setup.bash
 ros2 topic echo /address_book
+# shared-memory transport (Fast DDS profile in config/), and UDP loopback vs SHM benchmark for 1 KB - 100 MB
+ros2 launch more_interfaces address_book_launch.py transport:=shm
+ros2 launch more_interfaces transport_benchmark_launch.py transport:=udp payload:=address_book
+ros2 launch more_interfaces transport_benchmark_launch.py transport:=shm payload:=address_book
+ros2 launch more_interfaces transport_benchmark_launch.py transport:=shm payload:=fibonacci
+# one node subscribing to String/Num/Contact/AddressBook through a compile-time SubscriberSet; dispatch cost vs std::bind
+ros2 run more_interfaces aggregate_subscriber --ros-args -p dispatch.mode:=wait_set
+ros2 run more_interfaces dispatch_benchmark --ros-args -p threads:=4
+# contact directory indexed from the address_book stream, queried by phone / last-name prefix / phone_type
+ros2 run more_interfaces contact_directory --ros-args -p directory.synthetic:=2000000
+ros2 service call /query_contacts more_interfaces/srv/QueryContacts "{kind: 1, key: 'Mar', max_results: 5}"
+ros2 service call /query_contacts more_interfaces/srv/QueryContacts "{kind: 2, phone_type: 2, max_results: 10}"
+ros2 run more_interfaces contact_directory_benchmark 2000000 4
 
 
 #####6 Using parameters in a class (C++)
@@ -107,7 +168,17 @@ touch Fibonacci.action
 cd ros2_ws/src
 ros2 pkg create --dependencies action_tutorials_interfaces rclcpp rclcpp_action rclcpp_components -- action_tutorials_cpp
 ros2 run action_tutorials_cpp fibonacci_action_server
+# result cache: duplicate orders complete from cache, running duplicates share one computation
+ros2 run action_tutorials_cpp fibonacci_action_server --ros-args -p cache.ttl_ms:=30000 -p cache.max_bytes:=1048576
+ros2 topic echo /diagnostics
+ros2 launch action_tutorials_cpp fibonacci_shm_launch.py order:=40
 ros2 run action_tutorials_cpp fibonacci_action_client --ros-args -p order:=20
+# load test the action server: open_loop (rate_hz) or closed_loop (concurrency), random cancels
+ros2 run action_tutorials_cpp fibonacci_load_client --ros-args -p mode:=closed_loop -p concurrency:=8 -p total_goals:=200 -p order:=10 -p cancel_ratio:=0.1
+ros2 run action_tutorials_cpp fibonacci_load_client --ros-args -p mode:=open_loop -p rate_hz:=100.0 -p total_goals:=500 -p timeout_s:=30.0
+# goal journal: checkpoints in-flight goals to an mmap file; after a crash the server resumes them into the cache
+ros2 run action_tutorials_cpp fibonacci_action_server --ros-args -p journal.path:=/tmp/fibonacci.journal -p journal.checkpoint_every:=10
+ros2 run action_tutorials_cpp goal_journal_benchmark /tmp/goal_journal_benchmark.journal
 
 # 9 create a action server and client (Python)
 cd ros2_ws/src
\ No newline at end of file
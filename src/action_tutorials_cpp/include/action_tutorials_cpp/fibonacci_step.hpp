@@ -0,0 +1,34 @@
+#ifndef ACTION_TUTORIALS_CPP__FIBONACCI_STEP_HPP_
+#define ACTION_TUTORIALS_CPP__FIBONACCI_STEP_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "action_tutorials_cpp/goal_journal.hpp"
+
+namespace action_tutorials_cpp
+{
+
+// 追加斐波那契数列的下一项。无符号相加：order 超过 46 时按 int32 回绕，不是未定义行为
+inline void fibonacci_push_next(std::vector<int32_t> & sequence)
+{
+  auto n = sequence.size();
+  sequence.push_back(static_cast<int32_t>(
+      static_cast<uint32_t>(sequence[n - 1]) + static_cast<uint32_t>(sequence[n - 2])));
+}
+
+// FibonacciActionServer::execute 的一步计算（第 i 步，sequence 已有 i + 1 项）：追加下一项，
+// 每 checkpoint_every 步把进度写入日志槽位。journal 为空或 slot < 0 表示这次计算不记录
+inline void fibonacci_step(
+  std::vector<int32_t> & sequence, int i, GoalJournal * journal, int64_t slot, int checkpoint_every)
+{
+  fibonacci_push_next(sequence);
+  // 写检查点：几十字节的内存写入，不影响反馈节奏
+  if (i % checkpoint_every == 0 && journal != nullptr && slot >= 0) {
+    journal->checkpoint(slot, static_cast<int32_t>(sequence.size()), sequence.back());
+  }
+}
+
+}  // namespace action_tutorials_cpp
+
+#endif  // ACTION_TUTORIALS_CPP__FIBONACCI_STEP_HPP_
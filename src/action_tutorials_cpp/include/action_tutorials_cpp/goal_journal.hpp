@@ -0,0 +1,310 @@
+#ifndef ACTION_TUTORIALS_CPP__GOAL_JOURNAL_HPP_
+#define ACTION_TUTORIALS_CPP__GOAL_JOURNAL_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace action_tutorials_cpp
+{
+
+// 目标日志：把执行中的计算（目标 ID、order、进度）记录在内存映射文件里，进程崩溃后重启时恢复。
+//
+// 文件 = 文件头 + 固定数量的槽位，每个计算占一个槽位。每个槽位有两份记录（双缓冲），写检查点时
+// 写入较旧的那一份（代数 +1，最后写校验和），另一份保持不变；恢复时取校验和正确、代数最大的那份，
+// 所以写到一半时崩溃最多丢掉这一次检查点。检查点只是几十字节的内存写入，不调用 msync：
+// 进程崩溃后页缓存里的数据仍然在，只有整机掉电才可能丢失最近的检查点。
+//
+// 槽位的分配和释放加锁；检查点只写调用方自己的槽位，不加锁。
+class GoalJournal
+{
+public:
+  using Uuid = std::array<uint8_t, 16>;
+
+  enum class State : uint32_t
+  {
+    Free = 0,
+    Active = 1,
+  };
+
+  // 恢复出的一个未完成的计算
+  struct Entry
+  {
+    uint32_t slot;
+    Uuid uuid;
+    int32_t order;
+    int32_t progress;  // 已算出的序列长度
+    int32_t last;      // 序列最后一个值，恢复时用来核对
+  };
+
+  struct Stats
+  {
+    uint64_t checkpoints = 0;
+    uint64_t full = 0;        // 没有空闲槽位，未记录的计算数
+    uint64_t corrupted = 0;   // 恢复时两份记录都无效的槽位
+    size_t active = 0;
+  };
+
+  GoalJournal() = default;
+  GoalJournal(const GoalJournal &) = delete;
+  GoalJournal & operator=(const GoalJournal &) = delete;
+
+  ~GoalJournal() {close();}
+
+  // 打开（不存在或格式不符时新建）日志文件；失败时返回 false 并在 error 中说明原因
+  bool open(const std::string & path, uint32_t slots, std::string & error)
+  {
+    close();
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      error = "cannot open " + path + ": " + std::strerror(errno);
+      return false;
+    }
+    size_ = sizeof(FileHeader) + static_cast<size_t>(slots) * sizeof(Slot);
+    struct stat st;
+    bool reuse = ::fstat(fd_, &st) == 0 && static_cast<size_t>(st.st_size) == size_;
+    if (!reuse && ::ftruncate(fd_, 0) != 0) {
+      error = "cannot truncate " + path + ": " + std::strerror(errno);
+      close();
+      return false;
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+      error = "cannot resize " + path + ": " + std::strerror(errno);
+      close();
+      return false;
+    }
+    void * base = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (base == MAP_FAILED) {
+      error = "cannot map " + path + ": " + std::strerror(errno);
+      close();
+      return false;
+    }
+    header_ = static_cast<FileHeader *>(base);
+    slots_ = reinterpret_cast<Slot *>(static_cast<char *>(base) + sizeof(FileHeader));
+    slot_count_ = slots;
+
+    if (!reuse || std::memcmp(header_->magic, magic(), sizeof(header_->magic)) != 0 ||
+      header_->version != kVersion || header_->slot_count != slots ||
+      header_->record_size != sizeof(Record))
+    {
+      // 新文件或格式不符：清空重建，旧内容无法恢复
+      std::memset(base, 0, size_);
+      std::memcpy(header_->magic, magic(), sizeof(header_->magic));
+      header_->version = kVersion;
+      header_->slot_count = slots;
+      header_->record_size = sizeof(Record);
+    }
+    scan();
+    return true;
+  }
+
+  void close()
+  {
+    if (header_ != nullptr) {
+      ::munmap(header_, size_);
+      header_ = nullptr;
+      slots_ = nullptr;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    current_.clear();
+    free_.clear();
+  }
+
+  bool is_open() const {return header_ != nullptr;}
+
+  // 上次运行留下的未完成计算（open 时扫描得到）
+  const std::vector<Entry> & recovered() const {return recovered_;}
+
+  // 为新计算分配槽位；日志已满时返回 -1（计算照常进行，只是不可恢复）
+  int64_t begin(const Uuid & uuid, int32_t order, int32_t progress = 0, int32_t last = 0)
+  {
+    uint32_t slot;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (free_.empty()) {
+        ++stats_.full;
+        return -1;
+      }
+      slot = free_.back();
+      free_.pop_back();
+      ++stats_.active;
+    }
+    write(slot, State::Active, &uuid, order, progress, last);
+    return slot;
+  }
+
+  // 记录进度；slot 为 begin 的返回值（-1 时忽略）
+  void checkpoint(int64_t slot, int32_t progress, int32_t last)
+  {
+    if (slot < 0) {
+      return;
+    }
+    const Record & cur = slots_[slot].copy[current_[static_cast<size_t>(slot)]];
+    write(static_cast<uint32_t>(slot), State::Active, nullptr, cur.order, progress, last);
+    checkpoints_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // 计算完成或取消：释放槽位
+  void finish(int64_t slot)
+  {
+    if (slot < 0) {
+      return;
+    }
+    write(static_cast<uint32_t>(slot), State::Free, nullptr, 0, 0, 0);
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(static_cast<uint32_t>(slot));
+    --stats_.active;
+  }
+
+  Stats stats() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats s = stats_;
+    s.checkpoints = checkpoints_.load(std::memory_order_relaxed);
+    return s;
+  }
+
+  uint32_t slot_count() const {return slot_count_;}
+
+private:
+  static const char * magic() {return "FIBJRNL";}  // 含结尾的 '\0' 共 8 字节
+  static constexpr uint32_t kVersion = 1;
+
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t record_size;
+    uint32_t reserved[11];
+  };
+
+  struct Record
+  {
+    uint64_t generation;  // 0 表示从未写过
+    uint8_t uuid[16];
+    int32_t order;
+    int32_t progress;
+    int32_t last;
+    uint32_t state;
+    uint32_t checksum;    // 前面所有字段按 32 位字计算的 FNV-1a
+    uint32_t reserved;
+  };
+
+  struct Slot
+  {
+    Record copy[2];
+  };
+
+  static_assert(sizeof(FileHeader) == 64, "journal header layout changed");
+  static_assert(sizeof(Record) == 48, "journal record layout changed");
+
+  // 按 32 位字计算，每个字一次乘法：逐字节计算时校验和占了检查点的大部分开销
+  static uint32_t checksum(const Record & r)
+  {
+    static_assert(offsetof(Record, checksum) % sizeof(uint32_t) == 0, "checksum covers whole words");
+    auto p = reinterpret_cast<const char *>(&r);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(Record, checksum); i += sizeof(uint32_t)) {
+      uint32_t word;
+      std::memcpy(&word, p + i, sizeof(word));
+      hash ^= word;
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+  static bool valid(const Record & r)
+  {
+    return r.generation != 0 && r.checksum == checksum(r);
+  }
+
+  // 写入较旧的那份记录并切换；uuid 为空时沿用当前记录的 uuid
+  void write(
+    uint32_t slot, State state, const Uuid * uuid, int32_t order, int32_t progress, int32_t last)
+  {
+    Slot & s = slots_[slot];
+    uint8_t cur = current_[slot];
+    const Record & old = s.copy[cur];
+    Record r{};
+    r.generation = old.generation + 1;
+    if (uuid != nullptr) {
+      std::memcpy(r.uuid, uuid->data(), sizeof(r.uuid));
+    } else {
+      std::memcpy(r.uuid, old.uuid, sizeof(r.uuid));
+    }
+    r.order = order;
+    r.progress = progress;
+    r.last = last;
+    r.state = static_cast<uint32_t>(state);
+    r.checksum = checksum(r);
+    s.copy[cur ^ 1] = r;
+    current_[slot] = cur ^ 1;
+  }
+
+  void scan()
+  {
+    recovered_.clear();
+    current_.assign(slot_count_, 0);
+    free_.clear();
+    stats_ = Stats();
+    for (uint32_t i = slot_count_; i-- > 0; ) {  // 倒序压栈，先分配小编号的槽位
+      const Slot & s = slots_[i];
+      bool v0 = valid(s.copy[0]);
+      bool v1 = valid(s.copy[1]);
+      if (!v0 && !v1) {
+        if (s.copy[0].generation != 0 || s.copy[1].generation != 0) {
+          ++stats_.corrupted;
+        }
+        free_.push_back(i);
+        continue;
+      }
+      uint8_t cur = (v1 && (!v0 || s.copy[1].generation > s.copy[0].generation)) ? 1 : 0;
+      current_[i] = cur;
+      const Record & r = s.copy[cur];
+      if (r.state != static_cast<uint32_t>(State::Active)) {
+        free_.push_back(i);
+        continue;
+      }
+      Entry e;
+      e.slot = i;
+      std::memcpy(e.uuid.data(), r.uuid, e.uuid.size());
+      e.order = r.order;
+      e.progress = r.progress;
+      e.last = r.last;
+      recovered_.push_back(e);
+      ++stats_.active;
+    }
+  }
+
+  int fd_ = -1;
+  size_t size_ = 0;
+  FileHeader * header_ = nullptr;
+  Slot * slots_ = nullptr;
+  uint32_t slot_count_ = 0;
+  std::vector<uint8_t> current_;  // 每个槽位当前有效的记录（只由占用该槽位的线程修改）
+  std::vector<Entry> recovered_;
+
+  mutable std::mutex mutex_;      // 保护 free_ 和 stats_（checkpoints 除外）
+  std::vector<uint32_t> free_;
+  Stats stats_;
+  std::atomic<uint64_t> checkpoints_{0};
+};
+
+}  // namespace action_tutorials_cpp
+
+#endif  // ACTION_TUTORIALS_CPP__GOAL_JOURNAL_HPP_
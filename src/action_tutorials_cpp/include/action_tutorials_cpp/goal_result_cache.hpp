@@ -0,0 +1,137 @@
+#ifndef ACTION_TUTORIALS_CPP__GOAL_RESULT_CACHE_HPP_
+#define ACTION_TUTORIALS_CPP__GOAL_RESULT_CACHE_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace action_tutorials_cpp
+{
+
+// Fibonacci 结果缓存：以目标内容（order）为键，带 TTL 和内存预算的 LRU 缓存。
+// 本类不加锁，由调用方（FibonacciActionServer）负责同步。
+class GoalResultCache
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using Sequence = std::vector<int32_t>;
+
+  struct Stats
+  {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;    // 超出内存预算被淘汰
+    uint64_t expirations = 0;  // 超过 TTL 被淘汰
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+
+  GoalResultCache(std::chrono::milliseconds ttl, size_t max_bytes)
+  : ttl_(ttl), max_bytes_(max_bytes)
+  {
+  }
+
+  // 命中时把结果复制到 out 并返回 true；过期条目在这里顺便删除
+  bool lookup(int32_t order, Sequence & out, Clock::time_point now = Clock::now())
+  {
+    auto it = index_.find(order);
+    if (it == index_.end()) {
+      ++stats_.misses;
+      return false;
+    }
+    if (now - it->second->inserted > ttl_) {
+      erase(it->second);
+      ++stats_.expirations;
+      ++stats_.misses;
+      return false;
+    }
+    // 移到 LRU 链表头部
+    lru_.splice(lru_.begin(), lru_, it->second);
+    out = it->second->sequence;
+    ++stats_.hits;
+    return true;
+  }
+
+  void insert(int32_t order, const Sequence & sequence, Clock::time_point now = Clock::now())
+  {
+    auto it = index_.find(order);
+    if (it != index_.end()) {
+      erase(it->second);
+    }
+    size_t bytes = entry_bytes(sequence);
+    if (bytes > max_bytes_) {
+      return;  // 单个结果就超出预算，不缓存
+    }
+    lru_.push_front(Entry{order, sequence, now, bytes});
+    index_[order] = lru_.begin();
+    stats_.bytes += bytes;
+    ++stats_.insertions;
+
+    while (stats_.bytes > max_bytes_ && !lru_.empty()) {
+      erase(std::prev(lru_.end()));
+      ++stats_.evictions;
+    }
+  }
+
+  // 周期性清理过期条目，避免冷数据一直占用预算
+  void evict_expired(Clock::time_point now = Clock::now())
+  {
+    for (auto it = lru_.begin(); it != lru_.end(); ) {
+      auto next = std::next(it);
+      if (now - it->inserted > ttl_) {
+        erase(it);
+        ++stats_.expirations;
+      }
+      it = next;
+    }
+  }
+
+  Stats stats() const
+  {
+    Stats s = stats_;
+    s.entries = lru_.size();
+    return s;
+  }
+
+  size_t max_bytes() const {return max_bytes_;}
+
+private:
+  struct Entry
+  {
+    int32_t order;
+    Sequence sequence;
+    Clock::time_point inserted;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  // 估算内存占用：条目本身 + 序列数据 + 索引节点。按 size() 计：缓存里存的是拷贝，
+  // 拷贝只分配 size() 个元素，调用方（反馈消息）多预留的容量不属于缓存
+  static size_t entry_bytes(const Sequence & sequence)
+  {
+    return sizeof(Entry) + sequence.size() * sizeof(int32_t) +
+           sizeof(std::unordered_map<int32_t, EntryList::iterator>::value_type) + 2 * sizeof(void *);
+  }
+
+  void erase(EntryList::iterator it)
+  {
+    stats_.bytes -= it->bytes;
+    index_.erase(it->order);
+    lru_.erase(it);
+  }
+
+  std::chrono::milliseconds ttl_;
+  size_t max_bytes_;
+  EntryList lru_;
+  std::unordered_map<int32_t, EntryList::iterator> index_;
+  Stats stats_;
+};
+
+}  // namespace action_tutorials_cpp
+
+#endif  // ACTION_TUTORIALS_CPP__GOAL_RESULT_CACHE_HPP_
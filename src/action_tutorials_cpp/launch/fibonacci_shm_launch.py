@@ -0,0 +1,32 @@
+import os
+
+from ament_index_python.packages import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+
+
+# ros2 launch action_tutorials_cpp fibonacci_shm_launch.py order:=40
+def generate_launch_description():
+    env = dict(os.environ)
+    env['RMW_IMPLEMENTATION'] = 'rmw_fastrtps_cpp'
+    # the shared-memory profile is installed once, by more_interfaces
+    env['FASTRTPS_DEFAULT_PROFILES_FILE'] = os.path.join(
+        get_package_share_directory('more_interfaces'), 'config', 'fastdds_shm.xml')
+    return LaunchDescription([
+        DeclareLaunchArgument('order', default_value='20'),
+        Node(
+            package='action_tutorials_cpp',
+            executable='fibonacci_action_server',
+            output='screen',
+            env=env,
+        ),
+        Node(
+            package='action_tutorials_cpp',
+            executable='fibonacci_action_client',
+            output='screen',
+            parameters=[{'order': LaunchConfiguration('order')}],
+            env=env,
+        ),
+    ])
@@ -9,6 +9,7 @@
 #include "rclcpp/rclcpp.hpp"  // ROS2 基本功能
 #include "rclcpp_action/rclcpp_action.hpp"  // ROS2 Action 客户端 API
 #include "rclcpp_components/register_node_macro.hpp"  // 组件注册
+#include "tutorial_utils/startup.hpp"  // 启动阶段计时
 
 namespace action_tutorials_cpp  // 定义命名空间
 {
@@ -38,6 +39,7 @@ public:
     this->timer_ = this->create_wall_timer(
       std::chrono::milliseconds(500),
       std::bind(&FibonacciActionClient::send_goal, this));
+    tutorial_utils::startup_mark("node");
   }
 
   // 发送 Action 任务
@@ -48,11 +50,13 @@ public:
     // 取消定时器，确保任务只发送一次
     this->timer_->cancel();
 
-    // 等待 Action Server 可用
-    if (!this->client_ptr_->wait_for_action_server()) {
+    // 等待 Action Server 可用（阻塞在图变化事件上）
+    if (!tutorial_utils::wait_for_action_server(*this, *this->client_ptr_)) {
       RCLCPP_ERROR(this->get_logger(), "Action server not available after waiting");
       rclcpp::shutdown();
+      return;
     }
+    tutorial_utils::startup_mark("server");
 
     // 获取命令行参数
     int order = this->declare_parameter<int>("order", 20);  // 默认值为20
@@ -130,6 +134,7 @@ private:
         return;
     }
 
+    tutorial_utils::StartupProfiler::instance().finish("first_result", this->get_logger());
     // 任务成功，输出最终结果
     std::stringstream ss;
     ss << "Result received: ";
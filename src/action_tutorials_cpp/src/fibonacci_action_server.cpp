@@ -6,17 +6,32 @@
 3. 使用线程 (handle_accepted) 运行任务。
 4. 计算斐波那契数列 (execute)，支持反馈。
 5. 任务完成或取消。
+6. 结果缓存 (GoalResultCache)：相同 order 的目标直接从缓存完成，执行中的相同目标合并为一次计算。
+7. 目标日志 (GoalJournal，journal.path 非空时开启)：执行进度定期写入内存映射文件，进程崩溃重启后
+   从检查点继续计算。原来的目标句柄随进程一起消失，恢复的计算不推送反馈、不限速，结果进入缓存；
+   客户端重发相同 order 的目标时合并到恢复中的计算上或直接命中缓存。
+   ros2 run action_tutorials_cpp fibonacci_action_server --ros-args -p journal.path:=/tmp/fibonacci.journal
 */
 
+#include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "action_tutorials_interfaces/action/fibonacci.hpp" // Fibonacci action 接口
 #include "rclcpp/rclcpp.hpp"                                // ROS2 基本功能, 包含节点、日志、时间等
 #include "rclcpp_action/rclcpp_action.hpp"                  // ROS2 Action 服务器 API
 #include "rclcpp_components/register_node_macro.hpp"        // 组件注册, 用于注册节点, 使节点能够被其他节点加载
 #include "action_tutorials_cpp/visibility_control.h"        // 控制库的可见性, 用于确保 C++ 代码在 C 语言编译器下也能正确编译
+#include "action_tutorials_cpp/goal_result_cache.hpp"       // 结果缓存, 相同 order 的目标直接返回
+#include "action_tutorials_cpp/goal_journal.hpp"            // 目标日志, 崩溃后从检查点恢复计算
+#include "action_tutorials_cpp/fibonacci_step.hpp"          // 计算的一步, 与性能测试共用
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"          // 缓存统计通过 diagnostics 话题发布
+#include "tutorial_utils/startup.hpp"                        // 启动阶段计时
 
 namespace action_tutorials_cpp
 {
@@ -40,6 +55,28 @@ public:
     using namespace std::placeholders;
     t_start = Nanosecond();
     RCLCPP_INFO(this->get_logger(), "Starting Fibonacci action server, ts_start(s): %f", t_start/1e9);
+
+    // 结果缓存参数：相同 order 的目标直接从缓存返回，执行中的相同目标合并为一次计算
+    cache_enabled_ = this->declare_parameter<bool>("cache.enabled", true);
+    auto ttl_ms = this->declare_parameter<int>("cache.ttl_ms", 60000);
+    auto max_bytes = this->declare_parameter<int>("cache.max_bytes", 1024 * 1024);
+    auto diagnostics_period_ms = this->declare_parameter<int>("cache.diagnostics_period_ms", 1000);
+    cache_ = std::make_unique<GoalResultCache>(
+      std::chrono::milliseconds(ttl_ms), static_cast<size_t>(std::max(max_bytes, 0)));
+
+    // 目标日志参数：journal.path 为空时不记录；每 checkpoint_every 步写一次检查点
+    auto journal_path = this->declare_parameter<std::string>("journal.path", "");
+    auto journal_slots = this->declare_parameter<int>("journal.slots", 16384);
+    checkpoint_every_ = std::max(this->declare_parameter<int>("journal.checkpoint_every", 10), 1);
+    if (!journal_path.empty()) {
+      journal_ = std::make_unique<GoalJournal>();
+      std::string error;
+      if (!journal_->open(journal_path, static_cast<uint32_t>(std::max(journal_slots, 1)), error)) {
+        RCLCPP_ERROR(this->get_logger(), "Goal journal disabled: %s", error.c_str());
+        journal_.reset();
+      }
+    }
+
     // 创建一个Fibonacci动作服务器
     this->action_server_ = rclcpp_action::create_server<Fibonacci>(
       this,
@@ -47,18 +84,52 @@ public:
       std::bind(&FibonacciActionServer::handle_goal, this, _1, _2),
       std::bind(&FibonacciActionServer::handle_cancel, this, _1),
       std::bind(&FibonacciActionServer::handle_accepted, this, _1));
+
+    // 通过 diagnostics 话题报告缓存命中率和内存占用
+    diagnostics_publisher_ = this->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("diagnostics", 10);
+    diagnostics_timer_ = this->create_wall_timer(
+      std::chrono::milliseconds(std::max(diagnostics_period_ms, 1)),
+      std::bind(&FibonacciActionServer::publish_diagnostics, this));
+
+    if (journal_) {
+      resume_goals(journal_path);
+    }
+    tutorial_utils::startup_mark("node");
   }
 
 private:
+  // 正在执行的一次计算，所有相同 order 的目标句柄都挂在这里，共享反馈和结果
+  struct InFlight
+  {
+    int32_t order;
+    std::vector<std::shared_ptr<GoalHandleFibonacci>> goal_handles;
+    int64_t journal_slot = -1;  // 日志槽位，-1 表示未记录
+    bool resumed = false;       // 从日志恢复：没有目标句柄时也继续计算
+    int32_t resume_progress = 0;
+    int32_t resume_last = 0;
+  };
+
   rclcpp_action::Server<Fibonacci>::SharedPtr action_server_; // 动作服务器指针
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_publisher_;
+  rclcpp::TimerBase::SharedPtr diagnostics_timer_;
   uint64_t t_start;
   uint64_t t_end;
 
+  bool cache_enabled_;
+  std::mutex cache_mutex_;  // 保护 cache_、in_flight_ 和合并计数
+  std::unique_ptr<GoalResultCache> cache_;
+  std::unordered_map<int32_t, std::shared_ptr<InFlight>> in_flight_;
+  uint64_t coalesced_ = 0;  // 合并到已有计算上的目标数
+
+  std::unique_ptr<GoalJournal> journal_;  // 为空表示不记录
+  int checkpoint_every_ = 10;
+
   // 处理目标请求的回调函数
   rclcpp_action::GoalResponse handle_goal(
     const rclcpp_action::GoalUUID & uuid,
     std::shared_ptr<const Fibonacci::Goal> goal)
   {
+    tutorial_utils::StartupProfiler::instance().finish("first_goal", this->get_logger());
     RCLCPP_INFO(this->get_logger(), "Received goal request with order %d", goal->order);
     (void)uuid; // 防止未使用的警告
     return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE; // 接受并执行目标
@@ -77,34 +148,78 @@ private:
   void handle_accepted(const std::shared_ptr<GoalHandleFibonacci> goal_handle)
   {
     using namespace std::placeholders;
+    auto flight = std::make_shared<InFlight>();
+    flight->order = goal_handle->get_goal()->order;
+    flight->goal_handles.push_back(goal_handle);
+
+    if (cache_enabled_) {
+      std::unique_lock<std::mutex> lock(cache_mutex_);
+      // 1. 缓存命中：立即完成，不再重新计算和推送反馈
+      auto result = std::make_shared<Fibonacci::Result>();
+      if (cache_->lookup(flight->order, result->sequence)) {
+        lock.unlock();
+        goal_handle->succeed(result);
+        RCLCPP_INFO(this->get_logger(), "Goal with order %d served from cache", flight->order);
+        return;
+      }
+      // 2. 相同目标正在计算：挂到已有计算上，共享反馈
+      auto it = in_flight_.find(flight->order);
+      if (it != in_flight_.end()) {
+        it->second->goal_handles.push_back(goal_handle);
+        ++coalesced_;
+        RCLCPP_INFO(this->get_logger(), "Goal with order %d coalesced onto running computation", flight->order);
+        return;
+      }
+      in_flight_[flight->order] = flight;
+    }
+    if (journal_) {
+      flight->journal_slot = journal_->begin(goal_handle->get_goal_id(), flight->order);
+    }
     // 需要快速返回以避免阻塞执行器，因此启动一个新线程
-    std::thread{std::bind(&FibonacciActionServer::execute, this, _1), goal_handle}.detach();
+    std::thread{std::bind(&FibonacciActionServer::execute, this, _1), flight}.detach();
   }
 
-  // 执行目标的函数
-  void execute(const std::shared_ptr<GoalHandleFibonacci> goal_handle)
+  // 执行目标的函数，反馈会推送给所有挂在这次计算上的目标
+  void execute(const std::shared_ptr<InFlight> flight)
   {
     RCLCPP_INFO(this->get_logger(), "Executing goal");
     rclcpp::Rate loop_rate(1000); // 设置循环频率为1Hz
-    const auto goal = goal_handle->get_goal(); // 获取目标
     auto feedback = std::make_shared<Fibonacci::Feedback>(); // 创建反馈消息
     auto & sequence = feedback->partial_sequence; // 获取部分序列
     sequence.push_back(0); // 初始化斐波那契数列
     sequence.push_back(1);
-    auto result = std::make_shared<Fibonacci::Result>(); // 创建结果消息
+    std::vector<std::shared_ptr<GoalHandleFibonacci>> goal_handles;
 
-    for (int i = 1; (i < goal->order) && rclcpp::ok(); ++i) {
-      // 检查是否有取消请求
-      if (goal_handle->is_canceling()) {
-        result->sequence = sequence; // 设置结果序列
-        goal_handle->canceled(result); // 取消目标
+    // 从检查点恢复：前缀直接重算（只是加法），与日志中的最后一个值不符时从头开始
+    int start = 1;
+    if (flight->resumed && flight->resume_progress > 2) {
+      while (static_cast<int32_t>(sequence.size()) < flight->resume_progress) {
+        fibonacci_push_next(sequence);
+      }
+      if (sequence.back() == flight->resume_last) {
+        start = static_cast<int>(sequence.size()) - 1;
+      } else {
+        sequence.resize(2);
+      }
+    }
+
+    for (int i = start; (i < flight->order) && rclcpp::ok(); ++i) {
+      // 检查是否有取消请求，只取消提出请求的那个目标
+      if (!take_goal_handles(flight, sequence, goal_handles)) {
         RCLCPP_INFO(this->get_logger(), "Goal canceled");
+        finish_journal(flight);
         return;
       }
-      // 更新序列
-      sequence.push_back(sequence[i] + sequence[i - 1]);
+      // 更新序列，每 checkpoint_every_ 步写检查点
+      fibonacci_step(
+        sequence, i, journal_.get(), flight->journal_slot, checkpoint_every_);
+      if (goal_handles.empty()) {
+        continue;  // 恢复的计算还没有客户端关注：不推送反馈，不限速
+      }
       // 发布反馈
-      goal_handle->publish_feedback(feedback);
+      for (auto & goal_handle : goal_handles) {
+        goal_handle->publish_feedback(feedback);
+      }
       auto t_now = Nanosecond();
       RCLCPP_INFO(this->get_logger(), "Publish feedback: %d, ts: %f", sequence.back(), t_now/1e9);
 
@@ -112,13 +227,174 @@ private:
     }
 
     // 检查目标是否完成
+    if (!take_goal_handles(flight, sequence, goal_handles)) {
+      RCLCPP_INFO(this->get_logger(), "Goal canceled");
+      finish_journal(flight);
+      return;
+    }
+    if (!rclcpp::ok()) {
+      return;  // 进程正在退出：保留检查点，下次启动时恢复
+    }
+    finish_journal(flight);
+    {
+      // 结果写入缓存并结束这次计算；之后到达的相同目标会直接命中缓存
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      if (cache_enabled_) {
+        if (rclcpp::ok()) {
+          cache_->insert(flight->order, sequence);
+        }
+        in_flight_.erase(flight->order);
+      }
+      goal_handles.swap(flight->goal_handles);
+    }
     if (rclcpp::ok()) {
+      auto result = std::make_shared<Fibonacci::Result>(); // 创建结果消息
       result->sequence = sequence; // 设置结果序列
-      goal_handle->succeed(result); // 成功完成目标
+      for (auto & goal_handle : goal_handles) {
+        goal_handle->succeed(result); // 成功完成目标
+      }
       t_end = Nanosecond();
       RCLCPP_INFO(this->get_logger(), "Goal succeeded, ts_end(s): %f, duration(us): %f", t_end/1e9, (t_end-t_start)/1e3);
     }
   }
+
+  // 取消正在请求取消的目标，并把剩余目标复制到 goal_handles；
+  // 全部被取消时结束这次计算并返回 false
+  bool take_goal_handles(
+    const std::shared_ptr<InFlight> & flight,
+    const std::vector<int32_t> & sequence,
+    std::vector<std::shared_ptr<GoalHandleFibonacci>> & goal_handles)
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto & handles = flight->goal_handles;
+    for (auto it = handles.begin(); it != handles.end(); ) {
+      if ((*it)->is_canceling()) {
+        auto result = std::make_shared<Fibonacci::Result>();
+        result->sequence = sequence; // 设置结果序列
+        (*it)->canceled(result); // 取消目标
+        it = handles.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (handles.empty() && !flight->resumed) {
+      if (cache_enabled_) {
+        in_flight_.erase(flight->order);
+      }
+      return false;
+    }
+    goal_handles = handles;
+    return true;
+  }
+
+  void finish_journal(const std::shared_ptr<InFlight> & flight)
+  {
+    if (flight->journal_slot >= 0) {
+      journal_->finish(flight->journal_slot);
+      flight->journal_slot = -1;
+    }
+  }
+
+  // 恢复上次运行未完成的计算：相同 order 的条目合并为一次计算，从进度最大的检查点继续
+  void resume_goals(const std::string & path)
+  {
+    auto start = std::chrono::steady_clock::now();
+    const auto & entries = journal_->recovered();
+    if (entries.empty()) {
+      return;
+    }
+    if (!cache_enabled_) {
+      // 没有缓存时恢复的结果无处可去
+      for (const auto & entry : entries) {
+        journal_->finish(entry.slot);
+      }
+      RCLCPP_WARN(
+        this->get_logger(), "Discarded %zu journaled goals: resuming needs cache.enabled", entries.size());
+      return;
+    }
+    std::vector<std::shared_ptr<InFlight>> flights;
+    {
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      for (const auto & entry : entries) {
+        auto & flight = in_flight_[entry.order];
+        if (!flight) {
+          flight = std::make_shared<InFlight>();
+          flight->order = entry.order;
+          flight->resumed = true;
+          flights.push_back(flight);
+        } else if (entry.progress <= flight->resume_progress) {
+          journal_->finish(entry.slot);
+          continue;
+        } else {
+          journal_->finish(flight->journal_slot);
+        }
+        flight->journal_slot = entry.slot;
+        flight->resume_progress = entry.progress;
+        flight->resume_last = entry.last;
+      }
+    }
+    for (auto & flight : flights) {
+      std::thread{std::bind(&FibonacciActionServer::execute, this, std::placeholders::_1), flight}.detach();
+    }
+    auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    RCLCPP_INFO(
+      this->get_logger(), "Resumed %zu computations (%zu journaled goals) from %s in %.2f ms",
+      flights.size(), entries.size(), path.c_str(), ms);
+  }
+
+  // 发布缓存统计：命中率（含合并）、内存占用、淘汰次数
+  void publish_diagnostics()
+  {
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.name = std::string(this->get_name()) + ": result cache";
+    status.hardware_id = this->get_fully_qualified_name();
+
+    GoalResultCache::Stats stats;
+    uint64_t coalesced;
+    size_t in_flight;
+    {
+      std::lock_guard<std::mutex> lock(cache_mutex_);
+      cache_->evict_expired();
+      stats = cache_->stats();
+      coalesced = coalesced_;
+      in_flight = in_flight_.size();
+    }
+    // 合并的目标在 lookup 时记为未命中，但没有触发新的计算，因此按命中计算
+    uint64_t lookups = stats.hits + stats.misses;
+    double hit_ratio = lookups > 0 ?
+      static_cast<double>(stats.hits + coalesced) / static_cast<double>(lookups) : 0.0;
+    status.message = cache_enabled_ ? "enabled" : "disabled";
+
+    auto add = [&status](const std::string & key, const std::string & value) {
+        diagnostic_msgs::msg::KeyValue kv;
+        kv.key = key;
+        kv.value = value;
+        status.values.push_back(kv);
+      };
+    add("hits", std::to_string(stats.hits));
+    add("misses", std::to_string(stats.misses));
+    add("coalesced", std::to_string(coalesced));
+    add("hit_ratio", std::to_string(hit_ratio));
+    add("entries", std::to_string(stats.entries));
+    add("bytes", std::to_string(stats.bytes));
+    add("max_bytes", std::to_string(cache_->max_bytes()));
+    add("evictions", std::to_string(stats.evictions));
+    add("expirations", std::to_string(stats.expirations));
+    add("in_flight", std::to_string(in_flight));
+    if (journal_) {
+      auto journal = journal_->stats();
+      add("journal_active", std::to_string(journal.active));
+      add("journal_checkpoints", std::to_string(journal.checkpoints));
+      add("journal_full", std::to_string(journal.full));
+      add("journal_corrupted", std::to_string(journal.corrupted));
+    }
+
+    diagnostic_msgs::msg::DiagnosticArray array;
+    array.header.stamp = this->now();
+    array.status.push_back(status);
+    diagnostics_publisher_->publish(array);
+  }
 };  // class FibonacciActionServer
 
 }  // namespace action_tutorials_cpp
@@ -0,0 +1,338 @@
+/*FibonacciLoadClient：Fibonacci Action 服务器的压测客户端（容量规划工具）。
+与 FibonacciActionClient 只发送一个目标不同，它可以：
+1. 开环模式 (open_loop)：按固定速率 rate_hz 发送目标，不管服务器是否跟得上。
+2. 闭环模式 (closed_loop)：保持 concurrency 个目标同时在执行，完成一个补发一个。
+3. 通过 GoalUUID 跟踪每个目标的 接受延迟 / 首次反馈延迟 / 完成延迟。
+4. 按 cancel_ratio 随机取消一部分目标，用于覆盖服务器的 handle_cancel。
+5. 结束时打印延迟分布和吞吐量报告。
+
+ros2 run action_tutorials_cpp fibonacci_load_client --ros-args \
+  -p mode:=closed_loop -p concurrency:=8 -p total_goals:=200 -p order:=10 -p cancel_ratio:=0.1
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "action_tutorials_interfaces/action/fibonacci.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_action/rclcpp_action.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+
+namespace action_tutorials_cpp
+{
+
+class FibonacciLoadClient : public rclcpp::Node
+{
+public:
+  using Fibonacci = action_tutorials_interfaces::action::Fibonacci;
+  using GoalHandleFibonacci = rclcpp_action::ClientGoalHandle<Fibonacci>;
+  using Clock = std::chrono::steady_clock;
+
+  explicit FibonacciLoadClient(const rclcpp::NodeOptions & options)
+  : Node("fibonacci_load_client", options)
+  {
+    mode_ = this->declare_parameter<std::string>("mode", "closed_loop");  // open_loop | closed_loop
+    rate_hz_ = this->declare_parameter<double>("rate_hz", 50.0);          // 开环发送速率
+    concurrency_ = this->declare_parameter<int>("concurrency", 4);        // 闭环并发数
+    total_goals_ = this->declare_parameter<int>("total_goals", 100);      // 目标总数
+    order_ = this->declare_parameter<int>("order", 10);                   // 每个目标的 order
+    cancel_ratio_ = this->declare_parameter<double>("cancel_ratio", 0.0); // 随机取消比例 [0, 1]
+    timeout_s_ = this->declare_parameter<double>("timeout_s", 0.0);       // 0 表示不超时
+    auto seed = this->declare_parameter<int>("seed", 42);
+
+    if (mode_ != "open_loop" && mode_ != "closed_loop") {
+      RCLCPP_WARN(this->get_logger(), "Unknown mode '%s', falling back to closed_loop", mode_.c_str());
+      mode_ = "closed_loop";
+    }
+    rng_.seed(static_cast<std::mt19937::result_type>(seed));
+
+    this->client_ptr_ = rclcpp_action::create_client<Fibonacci>(this, "fibonacci");
+
+    // 与 FibonacciActionClient 一样，用一次性定时器延后启动，避免在构造函数中阻塞
+    this->start_timer_ = this->create_wall_timer(
+      std::chrono::milliseconds(500),
+      std::bind(&FibonacciLoadClient::start, this));
+  }
+
+private:
+  // 每个目标的时间戳记录，接受后以 GoalUUID 为键保存
+  struct GoalRecord
+  {
+    Clock::time_point sent;
+    Clock::time_point accepted;
+    Clock::time_point first_feedback;
+    Clock::time_point completed;
+    bool has_feedback = false;
+    bool cancel_requested = false;
+    GoalHandleFibonacci::SharedPtr handle;
+  };
+
+  void start()
+  {
+    this->start_timer_->cancel();
+
+    if (!this->client_ptr_->wait_for_action_server(std::chrono::seconds(10))) {
+      RCLCPP_ERROR(this->get_logger(), "Action server not available after waiting");
+      rclcpp::shutdown();
+      return;
+    }
+
+    RCLCPP_INFO(
+      this->get_logger(), "Load test: mode=%s goals=%d order=%d rate_hz=%.1f concurrency=%d cancel_ratio=%.2f",
+      mode_.c_str(), total_goals_, order_, rate_hz_, concurrency_, cancel_ratio_);
+
+    t_start_ = Clock::now();
+
+    if (timeout_s_ > 0.0) {
+      timeout_timer_ = this->create_wall_timer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(timeout_s_)),
+        [this]() {
+          RCLCPP_WARN(this->get_logger(), "Load test timed out after %.1f s", timeout_s_);
+          finish();
+        });
+    }
+
+    if (mode_ == "open_loop") {
+      auto period = std::chrono::duration<double>(1.0 / std::max(rate_hz_, 1e-3));
+      send_timer_ = this->create_wall_timer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(period),
+        [this]() {
+          if (sent_ >= total_goals_) {
+            send_timer_->cancel();
+            return;
+          }
+          send_one();
+        });
+    } else {
+      for (int i = 0; i < concurrency_ && sent_ < total_goals_; ++i) {
+        send_one();
+      }
+    }
+  }
+
+  void send_one()
+  {
+    using namespace std::placeholders;
+
+    auto record = std::make_shared<GoalRecord>();
+    auto goal_msg = Fibonacci::Goal();
+    goal_msg.order = order_;
+
+    auto send_goal_options = rclcpp_action::Client<Fibonacci>::SendGoalOptions();
+    // 接受之前还没有 UUID，因此用 lambda 捕获记录，接受后再按 UUID 登记
+    send_goal_options.goal_response_callback =
+      [this, record](std::shared_future<GoalHandleFibonacci::SharedPtr> future) {
+        goal_response_callback(record, future.get());
+      };
+    send_goal_options.feedback_callback =
+      std::bind(&FibonacciLoadClient::feedback_callback, this, _1, _2);
+    send_goal_options.result_callback =
+      std::bind(&FibonacciLoadClient::result_callback, this, _1);
+
+    ++sent_;
+    record->sent = Clock::now();
+    this->client_ptr_->async_send_goal(goal_msg, send_goal_options);
+  }
+
+  void goal_response_callback(
+    const std::shared_ptr<GoalRecord> & record,
+    GoalHandleFibonacci::SharedPtr goal_handle)
+  {
+    if (!goal_handle) {
+      ++rejected_;
+      on_goal_done();
+      return;
+    }
+    record->accepted = Clock::now();
+    record->handle = goal_handle;
+    accept_latencies_us_.push_back(to_us(record->accepted - record->sent));
+    goals_[goal_handle->get_goal_id()] = record;
+  }
+
+  void feedback_callback(
+    GoalHandleFibonacci::SharedPtr goal_handle,
+    const std::shared_ptr<const Fibonacci::Feedback>)
+  {
+    auto it = goals_.find(goal_handle->get_goal_id());
+    if (it == goals_.end()) {
+      return;  // 反馈先于接受响应到达，忽略
+    }
+    auto & record = it->second;
+    if (record->has_feedback) {
+      return;
+    }
+    record->has_feedback = true;
+    record->first_feedback = Clock::now();
+    feedback_latencies_us_.push_back(to_us(record->first_feedback - record->sent));
+
+    // 在目标执行过程中随机取消，确保服务器走到 handle_cancel 分支
+    if (cancel_ratio_ > 0.0 && uniform_(rng_) < cancel_ratio_) {
+      record->cancel_requested = true;
+      ++cancel_requests_;
+      try {
+        this->client_ptr_->async_cancel_goal(goal_handle);
+      } catch (const rclcpp_action::exceptions::UnknownGoalHandleError &) {
+        // 目标已经结束，取消请求来不及发出
+      }
+    }
+  }
+
+  void result_callback(const GoalHandleFibonacci::WrappedResult & result)
+  {
+    auto now = Clock::now();
+    switch (result.code) {
+      case rclcpp_action::ResultCode::SUCCEEDED:
+        ++succeeded_;
+        break;
+      case rclcpp_action::ResultCode::ABORTED:
+        ++aborted_;
+        break;
+      case rclcpp_action::ResultCode::CANCELED:
+        ++canceled_;
+        break;
+      default:
+        ++unknown_;
+        break;
+    }
+
+    auto it = goals_.find(result.goal_id);
+    if (it != goals_.end()) {
+      it->second->completed = now;
+      if (result.code == rclcpp_action::ResultCode::SUCCEEDED) {
+        completion_latencies_us_.push_back(to_us(now - it->second->sent));
+      }
+      goals_.erase(it);
+    }
+    t_last_done_ = now;
+    on_goal_done();
+  }
+
+  // 一个目标结束（被拒绝或得到结果）：闭环模式下补发，全部结束时打印报告
+  void on_goal_done()
+  {
+    ++done_;
+    if (mode_ == "closed_loop" && sent_ < total_goals_) {
+      send_one();
+    }
+    if (done_ >= total_goals_) {
+      finish();
+    }
+  }
+
+  void finish()
+  {
+    if (finished_) {
+      return;
+    }
+    finished_ = true;
+    if (send_timer_) {
+      send_timer_->cancel();
+    }
+    if (timeout_timer_) {
+      timeout_timer_->cancel();
+    }
+    print_report();
+    rclcpp::shutdown();
+  }
+
+  void print_report()
+  {
+    auto end = done_ > 0 ? t_last_done_ : Clock::now();
+    double elapsed_s = std::chrono::duration<double>(end - t_start_).count();
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "\n===== Fibonacci load test report =====\n"
+       << "mode: " << mode_ << ", order: " << order_ << "\n"
+       << "sent: " << sent_ << ", rejected: " << rejected_
+       << ", succeeded: " << succeeded_ << ", canceled: " << canceled_
+       << ", aborted: " << aborted_ << ", unknown: " << unknown_
+       << ", unfinished: " << (sent_ - done_) << "\n"
+       << "cancel requests: " << cancel_requests_ << "\n"
+       << "elapsed(s): " << std::setprecision(3) << elapsed_s
+       << ", throughput(goals/s): " << (elapsed_s > 0.0 ? succeeded_ / elapsed_s : 0.0) << "\n";
+    append_latency(ss, "accept", accept_latencies_us_);
+    append_latency(ss, "first feedback", feedback_latencies_us_);
+    append_latency(ss, "completion", completion_latencies_us_);
+    RCLCPP_INFO(this->get_logger(), "%s", ss.str().c_str());
+  }
+
+  static void append_latency(std::stringstream & ss, const char * name, std::vector<double> samples)
+  {
+    ss << std::setprecision(1) << name << " latency(us): ";
+    if (samples.empty()) {
+      ss << "n/a\n";
+      return;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (auto v : samples) {
+      sum += v;
+    }
+    ss << "n=" << samples.size()
+       << " min=" << samples.front()
+       << " mean=" << sum / samples.size()
+       << " p50=" << percentile(samples, 0.50)
+       << " p90=" << percentile(samples, 0.90)
+       << " p99=" << percentile(samples, 0.99)
+       << " max=" << samples.back() << "\n";
+  }
+
+  // 最近秩百分位数，samples 需已排序
+  static double percentile(const std::vector<double> & samples, double p)
+  {
+    auto rank = static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples[std::min(rank, samples.size() - 1)];
+  }
+
+  static double to_us(Clock::duration d)
+  {
+    return std::chrono::duration<double, std::micro>(d).count();
+  }
+
+  rclcpp_action::Client<Fibonacci>::SharedPtr client_ptr_;
+  rclcpp::TimerBase::SharedPtr start_timer_;
+  rclcpp::TimerBase::SharedPtr send_timer_;
+  rclcpp::TimerBase::SharedPtr timeout_timer_;
+
+  std::string mode_;
+  double rate_hz_;
+  int concurrency_;
+  int total_goals_;
+  int order_;
+  double cancel_ratio_;
+  double timeout_s_;
+
+  std::mt19937 rng_;
+  std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+
+  std::unordered_map<rclcpp_action::GoalUUID, std::shared_ptr<GoalRecord>> goals_;
+  std::vector<double> accept_latencies_us_;
+  std::vector<double> feedback_latencies_us_;
+  std::vector<double> completion_latencies_us_;
+
+  int sent_ = 0;
+  int done_ = 0;
+  int rejected_ = 0;
+  int succeeded_ = 0;
+  int canceled_ = 0;
+  int aborted_ = 0;
+  int unknown_ = 0;
+  int cancel_requests_ = 0;
+  bool finished_ = false;
+  Clock::time_point t_start_;
+  Clock::time_point t_last_done_;
+};  // class FibonacciLoadClient
+
+}  // namespace action_tutorials_cpp
+
+RCLCPP_COMPONENTS_REGISTER_NODE(action_tutorials_cpp::FibonacciLoadClient)
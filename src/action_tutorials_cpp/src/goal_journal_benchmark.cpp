@@ -0,0 +1,195 @@
+// goal_journal_benchmark：目标日志 (GoalJournal) 的开销和恢复时间。
+//  1. 每个反馈步骤的检查点开销：只计算斐波那契下一项 vs 每 1 / 10 步写一次检查点；
+//  2. 10k 个未完成目标：写入检查点后不调用 finish 直接关闭（模拟崩溃），测量重新打开、扫描
+//     和重算前缀的时间，并核对恢复出的进度；
+//  3. 写检查点时崩溃：破坏最新的一份记录，应恢复到上一个检查点。
+//
+// ros2 run action_tutorials_cpp goal_journal_benchmark [日志文件，默认 /tmp/goal_journal_benchmark.journal]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "action_tutorials_cpp/goal_journal.hpp"
+
+using action_tutorials_cpp::GoalJournal;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t kSlots = 16384;
+constexpr uint32_t kGoals = 10000;
+constexpr size_t kHeaderBytes = 64;
+constexpr size_t kRecordBytes = 48;
+
+volatile int32_t g_sink = 0;
+
+double since_ns(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+GoalJournal::Uuid make_uuid(uint32_t i)
+{
+  GoalJournal::Uuid uuid{};
+  for (size_t b = 0; b < 4; ++b) {
+    uuid[b] = static_cast<uint8_t>(i >> (8 * b));
+  }
+  return uuid;
+}
+
+// 与服务器相同：序列长度为 progress 时最后一个值（int32 溢出与服务器行为一致，用无符号计算）
+int32_t fib_last(int32_t progress)
+{
+  uint32_t a = 0;
+  uint32_t b = 1;
+  for (int32_t i = 2; i < progress; ++i) {
+    uint32_t c = a + b;
+    a = b;
+    b = c;
+  }
+  return static_cast<int32_t>(progress <= 1 ? 0 : b);
+}
+
+// 每步的平均耗时（ns）：计算下一项，每 every 步写一次检查点（0 表示不写）
+double step_cost(GoalJournal & journal, int every, int steps)
+{
+  int64_t slot = journal.begin(make_uuid(0), steps);
+  std::vector<int32_t> sequence;
+  sequence.reserve(static_cast<size_t>(steps) + 2);
+  auto start = Clock::now();
+  sequence.push_back(0);
+  sequence.push_back(1);
+  for (int i = 1; i < steps; ++i) {
+    sequence.push_back(static_cast<int32_t>(
+        static_cast<uint32_t>(sequence[i]) + static_cast<uint32_t>(sequence[i - 1])));
+    if (every > 0 && i % every == 0) {
+      journal.checkpoint(slot, static_cast<int32_t>(sequence.size()), sequence.back());
+    }
+  }
+  double ns = since_ns(start);
+  g_sink = sequence.back();
+  journal.finish(slot);
+  return ns / steps;
+}
+
+bool flip_byte(const std::string & path, size_t offset)
+{
+  std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+  if (!f) {
+    return false;
+  }
+  f.seekg(static_cast<std::streamoff>(offset));
+  char c = 0;
+  f.read(&c, 1);
+  c = static_cast<char>(c ^ 0x5a);
+  f.seekp(static_cast<std::streamoff>(offset));
+  f.write(&c, 1);
+  return static_cast<bool>(f);
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  std::string path = argc > 1 ? argv[1] : "/tmp/goal_journal_benchmark.journal";
+  std::remove(path.c_str());
+  std::string error;
+  int failures = 0;
+
+  // 1. 检查点开销
+  {
+    GoalJournal journal;
+    if (!journal.open(path, kSlots, error)) {
+      std::fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    const int steps = 2000000;
+    step_cost(journal, 0, steps);  // 预热
+    double base = step_cost(journal, 0, steps);
+    double every10 = step_cost(journal, 10, steps);
+    double every1 = step_cost(journal, 1, steps);
+    std::printf("per feedback step (ns): no journal %.2f, checkpoint every 10 %.2f, every step %.2f\n",
+      base, every10, every1);
+    std::printf("checkpoint cost: %.1f ns\n", every1 - base);
+  }
+
+  // 2. 10k 个未完成目标的恢复
+  std::vector<int32_t> progress(kGoals);
+  {
+    GoalJournal journal;
+    journal.open(path, kSlots, error);
+    for (uint32_t i = 0; i < kGoals; ++i) {
+      int32_t order = 10 + static_cast<int32_t>(i % 1000);
+      int64_t slot = journal.begin(make_uuid(i), order);
+      progress[i] = 2 + static_cast<int32_t>(i % static_cast<uint32_t>(order - 1));
+      for (int32_t p = 2; p <= progress[i]; p += 10) {
+        journal.checkpoint(slot, p, fib_last(p));
+      }
+      journal.checkpoint(slot, progress[i], fib_last(progress[i]));
+    }
+    // 不调用 finish：析构时只是解除映射，相当于进程在这里崩溃
+  }
+  {
+    auto start = Clock::now();
+    GoalJournal journal;
+    journal.open(path, kSlots, error);
+    double scan_ms = since_ns(start) / 1e6;
+    const auto & entries = journal.recovered();
+
+    // 恢复时服务器要重算每个计算的前缀
+    start = Clock::now();
+    size_t mismatched = 0;
+    std::vector<int32_t> sequence;
+    for (const auto & e : entries) {
+      sequence.assign({0, 1});
+      while (static_cast<int32_t>(sequence.size()) < e.progress) {
+        size_t n = sequence.size();
+        sequence.push_back(static_cast<int32_t>(
+            static_cast<uint32_t>(sequence[n - 1]) + static_cast<uint32_t>(sequence[n - 2])));
+      }
+      uint32_t id = static_cast<uint32_t>(e.uuid[0]) | (static_cast<uint32_t>(e.uuid[1]) << 8) |
+        (static_cast<uint32_t>(e.uuid[2]) << 16) | (static_cast<uint32_t>(e.uuid[3]) << 24);
+      if (id >= kGoals || e.progress != progress[id] || sequence.back() != e.last) {
+        ++mismatched;
+      }
+    }
+    double rebuild_ms = since_ns(start) / 1e6;
+    std::printf("recovery of %zu goals: open+scan %.2f ms, rebuild prefixes %.2f ms, total %.2f ms\n",
+      entries.size(), scan_ms, rebuild_ms, scan_ms + rebuild_ms);
+    if (entries.size() != kGoals || mismatched != 0) {
+      std::printf("FAIL: expected %u goals, got %zu (%zu mismatched)\n", kGoals, entries.size(), mismatched);
+      ++failures;
+    }
+  }
+
+  // 3. 写到一半崩溃：破坏最新一份记录，应回到上一个检查点
+  std::remove(path.c_str());
+  {
+    GoalJournal journal;
+    journal.open(path, 4, error);
+    int64_t slot = journal.begin(make_uuid(1), 100);  // 第 1 代写入 copy[1]
+    journal.checkpoint(slot, 20, fib_last(20));          // 第 2 代，copy[0]
+    journal.checkpoint(slot, 30, fib_last(30));          // 第 3 代，copy[1]
+  }
+  size_t newest = kHeaderBytes + 0 * 2 * kRecordBytes + 1 * kRecordBytes + 8;  // copy[1] 的 uuid
+  if (!flip_byte(path, newest)) {
+    std::printf("FAIL: cannot corrupt %s\n", path.c_str());
+    ++failures;
+  } else {
+    GoalJournal journal;
+    journal.open(path, 4, error);
+    const auto & entries = journal.recovered();
+    bool ok = entries.size() == 1 && entries[0].progress == 20 && entries[0].last == fib_last(20);
+    std::printf("torn checkpoint: %s\n", ok ? "recovered previous checkpoint" : "FAIL");
+    failures += ok ? 0 : 1;
+  }
+
+  std::remove(path.c_str());
+  return failures == 0 ? 0 : 1;
+}
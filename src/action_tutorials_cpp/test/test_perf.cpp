@@ -0,0 +1,93 @@
+// 性能回归门限（ctest 标签 perf）：FibonacciActionServer::execute 的计算循环，不含反馈发布和限速。
+// 结果与 test/perf_baseline.json 比较，判定规则和环境变量见 tutorial_utils/perf_gate.hpp。
+//
+// 只在 -DPERF_GATE=ON 时构建。在本机重新记录基线：PERF_GATE_UPDATE=1 colcon test --packages-select action_tutorials_cpp --ctest-args -L perf
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "action_tutorials_cpp/fibonacci_step.hpp"
+#include "action_tutorials_cpp/goal_journal.hpp"
+#include "action_tutorials_cpp/goal_result_cache.hpp"
+#include "tutorial_utils/perf_gate.hpp"
+
+using action_tutorials_cpp::GoalJournal;
+using action_tutorials_cpp::GoalResultCache;
+
+namespace
+{
+
+tutorial_utils::PerfGate & gate()
+{
+  static tutorial_utils::PerfGate instance(PERF_BASELINE_PATH);
+  return instance;
+}
+
+volatile int32_t g_sink = 0;
+
+// execute 去掉反馈和限速：逐步计算并写检查点，结束后释放槽位并写入缓存
+void execute_loop(GoalJournal & journal, GoalResultCache & cache, int32_t order, int checkpoint_every)
+{
+  int64_t slot = journal.begin(GoalJournal::Uuid{}, order);
+  std::vector<int32_t> sequence;
+  sequence.push_back(0);
+  sequence.push_back(1);
+  for (int i = 1; i < order; ++i) {
+    action_tutorials_cpp::fibonacci_step(sequence, i, &journal, slot, checkpoint_every);
+  }
+  journal.finish(slot);
+  cache.insert(order, sequence);
+  g_sink = sequence.back();
+}
+
+}  // namespace
+
+TEST(ActionPerf, fibonacci_execute_loop)
+{
+  if (gate().disabled()) {
+    return;
+  }
+  std::string path = testing::TempDir() + "action_perf.journal";
+  GoalJournal journal;
+  std::string error;
+  ASSERT_TRUE(journal.open(path, 16, error)) << error;
+  GoalResultCache cache(std::chrono::seconds(60), 1 << 20);
+
+  for (int32_t order : {10, 1000}) {
+    auto result = tutorial_utils::run_benchmark(
+      "fibonacci_execute_loop_order_" + std::to_string(order),
+      [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+          execute_loop(journal, cache, order, 10);
+        }
+      });
+    auto verdict = gate().check(result);
+    EXPECT_TRUE(verdict.passed()) << verdict.message;
+  }
+  journal.close();
+  std::remove(path.c_str());
+}
+
+TEST(ActionPerf, result_cache_hit)
+{
+  if (gate().disabled()) {
+    return;
+  }
+  GoalResultCache cache(std::chrono::seconds(60), 1 << 20);
+  GoalResultCache::Sequence sequence(100, 1);
+  cache.insert(100, sequence);
+  GoalResultCache::Sequence out;
+  auto result = tutorial_utils::run_benchmark(
+    "result_cache_hit_order_100", [&](uint64_t n) {
+      for (uint64_t i = 0; i < n; ++i) {
+        g_sink = cache.lookup(100, out) ? out.back() : 0;
+      }
+    });
+  auto verdict = gate().check(result);
+  EXPECT_TRUE(verdict.passed()) << verdict.message;
+}
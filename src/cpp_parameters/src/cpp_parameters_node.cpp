@@ -3,6 +3,7 @@
 #include <string>
 
 #include <rclcpp/rclcpp.hpp>
+#include "tutorial_utils/startup.hpp"
 
 using namespace std::chrono_literals;
 
@@ -24,6 +25,7 @@ public:
   {
     std::string my_param = this->get_parameter("my_parameter").as_string();
 
+    tutorial_utils::StartupProfiler::instance().finish("first_tick", this->get_logger());
     RCLCPP_INFO(this->get_logger(), "Hello %s!", my_param.c_str());
 
     std::vector<rclcpp::Parameter> all_new_parameters{rclcpp::Parameter("my_parameter", "world")};
@@ -37,7 +39,10 @@ private:
 int main(int argc, char ** argv)
 {
   rclcpp::init(argc, argv);
-  rclcpp::spin(std::make_shared<MinimalParam>());
+  tutorial_utils::startup_mark("init");
+  auto node = std::make_shared<MinimalParam>();
+  tutorial_utils::startup_mark("node");
+  rclcpp::spin(node);
   rclcpp::shutdown();
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef CPP_PUBSUB__LISTENER_HPP_
+#define CPP_PUBSUB__LISTENER_HPP_
+
+// listener 节点（src/listener.cpp 的 main 运行它），放在头文件里供测试在同一个执行器里运行。
+// 参数见 src/listener.cpp 开头的说明。
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include "rclcpp/rclcpp.hpp"       // ROS 2 C++ 节点库
+#include "std_msgs/msg/string.hpp" // ROS 2 标准消息类型（std_msgs::msg::String）
+#include "cpp_pubsub/payload_builder.hpp"       // 取消息末尾的序号
+#include "cpp_pubsub/rate_feedback.hpp"         // 发给发布端的频率反馈
+#include "tutorial_utils/pool_memory_strategy.hpp" // 内存池分配器和执行器内存策略
+#include "tutorial_utils/sequence_monitor.hpp"     // 序号跟踪和丢包诊断
+#include "tutorial_utils/startup.hpp"              // 启动阶段计时
+
+namespace cpp_pubsub
+{
+
+// 定义 Listener 类，继承自 rclcpp::Node
+class Listener : public rclcpp::Node {
+public:
+    // 构造函数：创建一个名为 "listener" 的 ROS 2 节点；options 供测试传入参数
+    explicit Listener(const rclcpp::NodeOptions & options = rclcpp::NodeOptions())
+    : Node("listener", options) {
+        // 内存池（memory.pool:=true 开启）：接收的消息对象和执行器内存从内存池分配
+        pool_ = tutorial_utils::declare_pool_parameters(*this);
+        pool_stats_timer_ = tutorial_utils::enable_pool(*this, pool_);
+
+        // 序号跟踪：每 sequence.window_ms 统计一次丢包率并发布诊断
+        sequence_monitor_ = std::make_unique<tutorial_utils::SequenceMonitor>(*this, "chatter");
+        // 频率反馈：每个窗口的消息年龄和丢包率
+        feedback_ = std::make_unique<cpp_pubsub::RateFeedbackReporter>(*this, "chatter", *sequence_monitor_);
+        // 每条消息额外忙等的时间（us），用来模拟处理不过来的订阅端
+        throttle_ = std::chrono::microseconds(this->declare_parameter<int>("throttle.work_us", 0));
+
+        // 创建订阅者，订阅 "chatter" 话题，队列大小设为 10
+        subscription_ = this->create_subscription<std_msgs::msg::String>(
+            "chatter", 10, 
+            // 绑定回调函数 topic_callback()，_1 代表接收到的消息，_2 代表消息元信息（含发布者 GID）
+            std::bind(&Listener::topic_callback, this, std::placeholders::_1, std::placeholders::_2),
+            tutorial_utils::pool_subscription_options());
+    }
+
+    bool pool_enabled() const { return pool_.enabled; }
+
+private:
+    // 话题回调函数，当收到 "chatter" 话题的消息时被调用
+    void topic_callback(const std_msgs::msg::String::SharedPtr msg, const rclcpp::MessageInfo & info) {
+        tutorial_utils::StartupProfiler::instance().finish("first_message", this->get_logger());
+        // 打印收到的消息内容
+        RCLCPP_INFO(this->get_logger(), "I heard: [%s]", msg->data.c_str());
+        feedback_->on_message(info);
+        if (throttle_.count() > 0) {
+            auto until = std::chrono::steady_clock::now() + throttle_;
+            while (std::chrono::steady_clock::now() < until) {
+            }
+        }
+
+        // 消息最后一个空格之后是发布端的计数器；不是 talker 格式的消息不参与统计
+        uint64_t seq = 0;
+        if (cpp_pubsub::parse_sequence(msg->data, seq)) {
+            sequence_monitor_->on_message(info, seq);
+        }
+    }
+
+    // 订阅者对象（订阅 "chatter" 话题的消息）
+    rclcpp::Subscription<std_msgs::msg::String, tutorial_utils::PoolAlloc>::SharedPtr subscription_;
+    rclcpp::TimerBase::SharedPtr pool_stats_timer_;  // 周期打印内存池计数
+    tutorial_utils::PoolOptions pool_;               // 内存池参数
+    std::unique_ptr<tutorial_utils::SequenceMonitor> sequence_monitor_;  // 按发布者跟踪序号
+    std::unique_ptr<cpp_pubsub::RateFeedbackReporter> feedback_;         // 频率反馈
+    std::chrono::microseconds throttle_;                                 // 模拟的处理耗时
+};
+
+}  // namespace cpp_pubsub
+
+#endif  // CPP_PUBSUB__LISTENER_HPP_
@@ -0,0 +1,115 @@
+#ifndef CPP_PUBSUB__NUM_BATCHER_HPP_
+#define CPP_PUBSUB__NUM_BATCHER_HPP_
+
+// Num 批量发布：把多个值合并成一帧 tutorial_interfaces/NumArray 发布，分摊每条消息的固定开销
+// （序列化、rmw 调用、UDP/SHM 报文头，都远大于 8 字节的 Num）。
+//
+//  - NumBatchPublisher：add() 把值追加到当前帧，攒够 max_items 个立即发出；否则在第一个值进入帧
+//    max_delay 之后由定时器发出，所以每个值的额外延迟不超过 max_delay。
+//  - create_num_batch_subscription()：订阅帧，按顺序对每个值调用逐条回调，订阅端代码不用改。
+//
+// 批量话题为 "<topic>/batch"（类型与 Num 话题不同，不能共用一个话题名）。
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "rclcpp/rclcpp.hpp"
+#include "tutorial_interfaces/msg/num_array.hpp"
+
+namespace cpp_pubsub
+{
+
+inline std::string num_batch_topic(const std::string & topic)
+{
+  return topic + "/batch";
+}
+
+inline int64_t system_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+class NumBatchPublisher
+{
+public:
+  using NumArray = tutorial_interfaces::msg::NumArray;
+
+  NumBatchPublisher(
+    rclcpp::Node & node, const std::string & topic, size_t max_items,
+    std::chrono::microseconds max_delay, const rclcpp::QoS & qos = rclcpp::QoS(10))
+  : max_items_(max_items > 0 ? max_items : 1)
+  {
+    publisher_ = node.create_publisher<NumArray>(num_batch_topic(topic), qos);
+    frame_.nums.reserve(max_items_);
+    // 第一个值进入帧时 reset()，定时器从那一刻开始计时，到期时帧里若还有值就发出
+    timer_ = node.create_wall_timer(
+      max_delay.count() > 0 ? max_delay : std::chrono::microseconds(1000),
+      [this]() {flush();});
+  }
+
+  void add(int64_t value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frame_.nums.empty()) {
+      frame_.oldest_stamp_ns = system_now_ns();
+      timer_->reset();
+    }
+    frame_.nums.push_back(value);
+    if (frame_.nums.size() >= max_items_) {
+      publish_locked();
+    }
+  }
+
+  void flush()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!frame_.nums.empty()) {
+      publish_locked();
+    }
+  }
+
+  uint64_t frames() const {return frames_;}
+  size_t max_items() const {return max_items_;}
+  const rmw_gid_t & get_gid() const {return publisher_->get_gid();}
+
+private:
+  void publish_locked()
+  {
+    publisher_->publish(frame_);
+    frame_.nums.clear();  // 保留容量，下一帧不再分配
+    ++frames_;
+  }
+
+  size_t max_items_;
+  rclcpp::Publisher<NumArray>::SharedPtr publisher_;
+  rclcpp::TimerBase::SharedPtr timer_;
+  std::mutex mutex_;
+  NumArray frame_;
+  uint64_t frames_ = 0;
+};
+
+// callback(value, info) 对帧中每个值调用一次，info 是整帧的消息元信息（发布者 GID、时间戳）
+template<typename CallbackT>
+rclcpp::Subscription<tutorial_interfaces::msg::NumArray>::SharedPtr create_num_batch_subscription(
+  rclcpp::Node & node, const std::string & topic, const rclcpp::QoS & qos, CallbackT && callback)
+{
+  using NumArray = tutorial_interfaces::msg::NumArray;
+  return node.create_subscription<NumArray>(
+    num_batch_topic(topic), qos,
+    [callback = std::forward<CallbackT>(callback)](
+      const NumArray::SharedPtr frame, const rclcpp::MessageInfo & info) {
+      for (auto value : frame->nums) {
+        callback(value, info);
+      }
+    });
+}
+
+}  // namespace cpp_pubsub
+
+#endif  // CPP_PUBSUB__NUM_BATCHER_HPP_
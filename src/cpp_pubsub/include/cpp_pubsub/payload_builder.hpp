@@ -0,0 +1,116 @@
+#ifndef CPP_PUBSUB__PAYLOAD_BUILDER_HPP_
+#define CPP_PUBSUB__PAYLOAD_BUILDER_HPP_
+
+// Talker 消息构造："<前缀><时间戳后两位> <计数>"。
+//
+//  - BuildMode::Concat：原来的写法，每次 operator+ 拼接整个字符串，两次 std::to_string，
+//    成本与前缀长度成正比，并产生若干临时分配。
+//  - BuildMode::InPlace：前缀只在构造时写入一次，每次只用 std::to_chars 原地改写后缀，
+//    字符串容量预留足够，不分配内存，成本与前缀长度无关。
+//
+// PayloadBuilder<Bytes, Mode> 以总长度为模板参数，payload_build_benchmark 用它比较
+// 16 B 到 1 MB 各长度下两种模式的构造开销。
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace cpp_pubsub
+{
+
+enum class BuildMode
+{
+  Concat,
+  InPlace,
+};
+
+// 后缀最长："<两位时间戳> <uint64 计数>"
+constexpr size_t kMaxSuffix = 2 + 1 + 20;
+
+// 在 data 的前 prefix_len 字节之后写入后缀；调用方需预留 prefix_len + kMaxSuffix 的容量
+inline void write_suffix(std::string & data, size_t prefix_len, uint64_t stamp, uint64_t count)
+{
+  char suffix[kMaxSuffix];
+  char * end = suffix + sizeof(suffix);
+  auto r = std::to_chars(suffix, end, stamp % 100);
+  *r.ptr++ = ' ';
+  r = std::to_chars(r.ptr, end, count);
+  data.resize(prefix_len);  // 只缩短，不改动前缀
+  data.append(suffix, static_cast<size_t>(r.ptr - suffix));
+}
+
+// 取出消息末尾的计数（最后一个空格之后），listener 用它跟踪序号；不是 talker 格式时返回 false
+inline bool parse_sequence(const std::string & data, uint64_t & seq)
+{
+  auto pos = data.rfind(' ');
+  if (pos == std::string::npos || pos + 1 >= data.size()) {
+    return false;
+  }
+  char * end = nullptr;
+  seq = std::strtoull(data.c_str() + pos + 1, &end, 10);
+  return *end == '\0';
+}
+
+// 填充前缀，加上最长后缀后总长为 bytes（bytes 不足 kMaxSuffix 时前缀为空），已预留后缀容量
+inline std::string make_prefix(size_t bytes)
+{
+  size_t prefix_len = bytes > kMaxSuffix ? bytes - kMaxSuffix : 0;
+  std::string prefix;
+  prefix.reserve(prefix_len + kMaxSuffix);
+  static const char kPattern[] = "Hello, world, this is a test! ";
+  for (size_t i = 0; i < prefix_len; ++i) {
+    prefix.push_back(kPattern[i % (sizeof(kPattern) - 1)]);
+  }
+  return prefix;
+}
+
+template<size_t Bytes, BuildMode Mode>
+class PayloadBuilder;
+
+template<size_t Bytes>
+class PayloadBuilder<Bytes, BuildMode::Concat>
+{
+public:
+  static constexpr size_t kBytes = Bytes;
+
+  PayloadBuilder()
+  : prefix_(make_prefix(Bytes)) {}
+
+  void prime(std::string &) const {}
+
+  void build(std::string & out, uint64_t stamp, uint64_t count) const
+  {
+    out = prefix_ + std::to_string(stamp % 100) + " " + std::to_string(count);
+  }
+
+private:
+  std::string prefix_;
+};
+
+template<size_t Bytes>
+class PayloadBuilder<Bytes, BuildMode::InPlace>
+{
+public:
+  static constexpr size_t kBytes = Bytes;
+
+  PayloadBuilder()
+  : prefix_len_(Bytes > kMaxSuffix ? Bytes - kMaxSuffix : 0) {}
+
+  // 写入前缀并预留后缀容量，只需调用一次
+  void prime(std::string & out) const {out = make_prefix(Bytes);}
+
+  // 只改写后缀
+  void build(std::string & out, uint64_t stamp, uint64_t count) const
+  {
+    write_suffix(out, prefix_len_, stamp, count);
+  }
+
+private:
+  size_t prefix_len_;
+};
+
+}  // namespace cpp_pubsub
+
+#endif  // CPP_PUBSUB__PAYLOAD_BUILDER_HPP_
@@ -0,0 +1,163 @@
+#ifndef CPP_PUBSUB__RATE_FEEDBACK_HPP_
+#define CPP_PUBSUB__RATE_FEEDBACK_HPP_
+
+// 自适应发布频率（AIMD，见 tutorial_utils/aimd_rate.hpp）。
+//
+//  - RateFeedbackReporter（订阅端）：按发布者 GID 统计消息年龄（接收时刻 - source timestamp），
+//    每个 sequence.window_ms 窗口结束时连同 SequenceMonitor 的丢包率一起发布
+//    tutorial_interfaces/RateFeedback 到 "<topic>/rate_feedback"。
+//  - AdaptivePublishRate（发布端）：adaptive.enabled:=true 时订阅反馈，只处理自己 GID 的消息，
+//    调整频率；固定频率的定时器每次触发先调用 admit()，返回 false 就跳过这次发布。
+//
+// 反馈窗口就是 sequence.window_ms，自适应时建议设为 100：
+//   ros2 run cpp_pubsub listener --ros-args -p sequence.window_ms:=100 -p throttle.work_us:=3000
+//   ros2 run cpp_pubsub talker --ros-args -p adaptive.enabled:=true -p adaptive.target_age_ms:=10
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "tutorial_interfaces/msg/rate_feedback.hpp"
+#include "tutorial_utils/aimd_rate.hpp"
+#include "tutorial_utils/sequence_monitor.hpp"
+
+namespace cpp_pubsub
+{
+
+inline std::string rate_feedback_topic(const std::string & topic)
+{
+  return topic + "/rate_feedback";
+}
+
+class RateFeedbackReporter
+{
+public:
+  using Gid = tutorial_utils::SequenceMonitor::Gid;
+
+  RateFeedbackReporter(
+    rclcpp::Node & node, const std::string & topic, tutorial_utils::SequenceMonitor & monitor)
+  {
+    publisher_ = node.create_publisher<tutorial_interfaces::msg::RateFeedback>(
+      rate_feedback_topic(topic), 10);
+    monitor.on_window([this](const Gid & gid, double loss) {publish(gid, loss);});
+  }
+
+  // 在订阅回调里调用；rmw 不提供 source timestamp 时只上报丢包率
+  void on_message(const rclcpp::MessageInfo & info)
+  {
+    const auto & rmw_info = info.get_rmw_message_info();
+    Gid gid;
+    std::memcpy(gid.data(), rmw_info.publisher_gid.data, gid.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto & window = windows_[gid];
+    ++window.received;
+    if (rmw_info.source_timestamp > 0) {
+      int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+      double age_ms = static_cast<double>(now_ns - rmw_info.source_timestamp) / 1e6;
+      window.max_age_ms = std::max(window.max_age_ms, age_ms);
+      window.age_ms_total += age_ms;
+      ++window.aged;
+    }
+  }
+
+private:
+  struct Window
+  {
+    uint32_t received = 0;
+    uint32_t aged = 0;
+    double max_age_ms = 0.0;
+    double age_ms_total = 0.0;
+  };
+
+  void publish(const Gid & gid, double loss)
+  {
+    tutorial_interfaces::msg::RateFeedback msg;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Window & window = windows_[gid];
+      msg.received = window.received;
+      msg.max_age_ms = window.max_age_ms;
+      msg.mean_age_ms = window.aged > 0 ? window.age_ms_total / window.aged : 0.0;
+      window = Window();
+    }
+    msg.publisher_gid.assign(gid.begin(), gid.end());
+    msg.loss_rate = loss;
+    publisher_->publish(msg);
+  }
+
+  rclcpp::Publisher<tutorial_interfaces::msg::RateFeedback>::SharedPtr publisher_;
+  std::mutex mutex_;
+  std::map<Gid, Window> windows_;
+};
+
+class AdaptivePublishRate
+{
+public:
+  // 声明 adaptive.* 参数；base_hz 是发布定时器的频率，也是上限
+  AdaptivePublishRate(rclcpp::Node & node, const std::string & topic, double base_hz)
+  : base_hz_(base_hz), logger_(node.get_logger())
+  {
+    enabled_ = node.declare_parameter<bool>("adaptive.enabled", false);
+    tutorial_utils::AimdConfig config;
+    config.max_hz = base_hz;
+    config.min_hz = node.declare_parameter<double>("adaptive.min_hz", config.min_hz);
+    config.target_age_ms = node.declare_parameter<double>("adaptive.target_age_ms", config.target_age_ms);
+    config.max_loss_rate = node.declare_parameter<double>("adaptive.max_loss_rate", config.max_loss_rate);
+    config.increase_hz = node.declare_parameter<double>("adaptive.increase_hz", config.increase_hz);
+    config.decrease_factor =
+      node.declare_parameter<double>("adaptive.decrease_factor", config.decrease_factor);
+    controller_ = tutorial_utils::AimdRateController(config);
+    if (!enabled_) {
+      return;
+    }
+    subscription_ = node.create_subscription<tutorial_interfaces::msg::RateFeedback>(
+      rate_feedback_topic(topic), 10,
+      [this](const tutorial_interfaces::msg::RateFeedback::SharedPtr msg) {on_feedback(*msg);});
+  }
+
+  // 发布者创建后调用，用于过滤其他发布者的反馈
+  void set_publisher_gid(const rmw_gid_t & gid) {gid_ = gid;}
+
+  // 定时器每次触发时调用；未开启时总是 true
+  bool admit() {return !enabled_ || controller_.admit(base_hz_);}
+
+  bool enabled() const {return enabled_;}
+  double rate_hz() const {return controller_.rate_hz();}
+
+private:
+  void on_feedback(const tutorial_interfaces::msg::RateFeedback & msg)
+  {
+    // 只接受完整的 GID：空的或截断的 GID 会和任何发布者比较相等
+    if (msg.publisher_gid.size() != sizeof(gid_.data) ||
+      std::memcmp(msg.publisher_gid.data(), gid_.data, sizeof(gid_.data)) != 0)
+    {
+      return;
+    }
+    double before = controller_.rate_hz();
+    if (controller_.on_feedback(msg.max_age_ms, msg.loss_rate) ==
+      tutorial_utils::AimdRateController::Action::Decrease)
+    {
+      RCLCPP_INFO(
+        logger_, "subscriber behind (max age %.1f ms, loss %.2f%%): rate %.0f -> %.0f Hz",
+        msg.max_age_ms, msg.loss_rate * 100.0, before, controller_.rate_hz());
+    }
+  }
+
+  double base_hz_;
+  bool enabled_ = false;
+  rclcpp::Logger logger_;
+  rmw_gid_t gid_{};
+  tutorial_utils::AimdRateController controller_;
+  rclcpp::Subscription<tutorial_interfaces::msg::RateFeedback>::SharedPtr subscription_;
+};
+
+}  // namespace cpp_pubsub
+
+#endif  // CPP_PUBSUB__RATE_FEEDBACK_HPP_
@@ -0,0 +1,105 @@
+#ifndef CPP_PUBSUB__SCALING_NODES_HPP_
+#define CPP_PUBSUB__SCALING_NODES_HPP_
+
+// 规模测试用的 talker / listener 组件（scaling_harness 在一个进程里组合 N 个 talker 和 M 个 listener，
+// 也可以加载到 component_container）。消息格式与 Talker 相同："<前缀><时间戳> <序号>"，
+// 用 payload_builder.hpp 原地构造；延迟取 rmw 的 source timestamp，不占用消息内容。
+//
+// 话题分配（topology）：
+//  - shared：所有 talker 发布、所有 listener 订阅同一个话题 scaling_0（N×M 条连接，扇入+扇出）
+//  - disjoint：共 topics 个话题，talker i 发布到 scaling_<i % topics>，listener j 订阅 scaling_<j % topics>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "tutorial_utils/sequence_monitor.hpp"
+#include "tutorial_utils/sequence_tracker.hpp"
+
+namespace cpp_pubsub
+{
+
+inline std::string scaling_topic(size_t index) {return "scaling_" + std::to_string(index);}
+
+// 在给定拓扑下，订阅 topic_index 的 listener 应该看到的发布者数量
+inline size_t scaling_expected_publishers(
+  const std::string & topology, size_t talkers, size_t topics, size_t topic_index)
+{
+  if (topology != "disjoint" || topics == 0) {
+    return talkers;
+  }
+  return talkers / topics + (topic_index < talkers % topics ? 1 : 0);
+}
+
+// 参数：topic（默认 scaling_0）、rate_hz（默认 100）、payload_bytes（默认 128）
+class ScalingTalker : public rclcpp::Node
+{
+public:
+  explicit ScalingTalker(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+
+  uint64_t sent() const {return sent_.load(std::memory_order_relaxed);}
+
+private:
+  void on_timer();
+
+  rclcpp::Publisher<std_msgs::msg::String>::SharedPtr publisher_;
+  rclcpp::TimerBase::SharedPtr timer_;
+  std_msgs::msg::String message_;
+  size_t prefix_len_ = 0;
+  std::atomic<uint64_t> sent_{0};
+};
+
+// 参数：topic、expected_publishers（发现完成的判据，默认 1）、max_samples（每个 listener 保留的延迟样本数）
+class ScalingListener : public rclcpp::Node
+{
+public:
+  struct Stats
+  {
+    bool discovered = false;
+    double discovery_ms = 0.0;      // 从计时起点到匹配到 expected_publishers 个发布者
+    double first_message_ms = 0.0;  // 从计时起点到收到第一条消息，0 表示还没收到
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    std::vector<float> latency_us;
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  explicit ScalingListener(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+
+  // 计时起点：scaling_harness 在执行器开始 spin 前给所有 listener 设同一个起点，
+  // 这样先创建的 listener 不会把其余节点的创建时间算进发现时间（创建时间另见 create_ms）。
+  // 没有设置时（例如加载到 component_container）取发现定时器第一次触发，即执行器开始 spin 的时间
+  void start_clock(Clock::time_point start);
+
+  // 发现完成时返回 true 并给出耗时
+  bool discovery(double & ms);
+
+  // 取出统计；reset 为 true 时清零（发现完成后用来去掉预热阶段）
+  Stats take_stats(bool reset);
+
+private:
+  void on_message(const std_msgs::msg::String::SharedPtr & msg, const rclcpp::MessageInfo & info);
+  void check_discovery();
+
+  rclcpp::Subscription<std_msgs::msg::String>::SharedPtr subscription_;
+  rclcpp::TimerBase::SharedPtr discovery_timer_;
+  Clock::time_point started_{};  // 计时起点，未设置时为 epoch
+  size_t expected_publishers_ = 1;
+  size_t max_samples_ = 20000;
+
+  std::mutex mutex_;
+  Stats stats_;
+  std::map<tutorial_utils::SequenceMonitor::Gid, tutorial_utils::SequenceTracker> trackers_;
+  uint64_t lost_base_ = 0;  // reset 时的累计丢失数
+};
+
+}  // namespace cpp_pubsub
+
+#endif  // CPP_PUBSUB__SCALING_NODES_HPP_
@@ -0,0 +1,111 @@
+#ifndef CPP_PUBSUB__TALKER_HPP_
+#define CPP_PUBSUB__TALKER_HPP_
+
+// talker 节点（src/talker.cpp 的 main 运行它），放在头文件里供测试在同一个执行器里运行。
+// 参数见 src/talker.cpp 开头的说明。
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include "rclcpp/rclcpp.hpp"  // ROS 2 C++ 客户端库，提供节点、日志、发布订阅等功能
+#include "std_msgs/msg/string.hpp"  // 引入标准的 String 消息类型
+#include "cpp_pubsub/payload_builder.hpp"  // 只改写后缀的消息构造
+#include "cpp_pubsub/rate_feedback.hpp"  // 根据订阅端反馈调整发布频率（AIMD）
+#include "tutorial_utils/pool_memory_strategy.hpp"  // 内存池分配器和执行器内存策略
+#include "tutorial_utils/realtime.hpp"  // mlockall / 预取内存 / SCHED_FIFO / CPU 亲和性
+#include "tutorial_utils/startup.hpp"  // 启动阶段计时（TUTORIAL_STARTUP_PROFILE=1 时打印）
+
+namespace cpp_pubsub
+{
+
+// 消息的固定前缀
+inline constexpr char kGreeting[] =
+    "Hello, world, this is a test, not a real message, but the message is not empty, is very long, and it is a test! ";
+
+// 定义 Talker 类，继承自 rclcpp::Node，它是一个 ROS 2 的发布者节点
+class Talker : public rclcpp::Node {
+public:
+    // 构造函数，初始化节点3；options 供测试传入参数
+    explicit Talker(const rclcpp::NodeOptions & options = rclcpp::NodeOptions())
+    : Node("talker", options), count_(0) {
+        // 实时模式：锁定内存、预取堆和栈、设置 SCHED_FIFO 优先级和 CPU 亲和性（权限不足时降级运行）
+        realtime_ = tutorial_utils::declare_realtime_parameters(*this);
+        // 内存池（memory.pool:=true 开启，实时模式下总是开启）：发布者和执行器的内存从内存池分配
+        pool_ = tutorial_utils::declare_pool_parameters(*this);
+        if (realtime_.enabled) {
+            tutorial_utils::apply_realtime(realtime_, this->get_logger());
+            pool_.enabled = true;
+        }
+        pool_stats_timer_ = tutorial_utils::enable_pool(*this, pool_);  // 在进入稳态前创建并预取内存池
+        // 消息构造方式：concat（每次拼接整个字符串）或 in_place（只用 to_chars 改写后缀），实时模式下总是 in_place
+        in_place_ = this->declare_parameter<std::string>("message.build_mode", "concat") == "in_place" ||
+            realtime_.enabled;
+
+        // 创建一个发布者，发布 std_msgs::msg::String 类型的消息，话题名为 "chatter"，队列大小 10
+        publisher_ = this->create_publisher<std_msgs::msg::String>(
+            "chatter", 10, tutorial_utils::pool_publisher_options());
+
+        // 自适应频率（adaptive.enabled:=true 开启）：订阅端处理不过来时降低频率，而不是让它丢消息
+        adaptive_ = std::make_unique<cpp_pubsub::AdaptivePublishRate>(*this, "chatter", 1000.0);
+        adaptive_->set_publisher_gid(publisher_->get_gid());
+
+        // 预分配消息：in_place 模式下回调中只原地改写前缀后面的数字，不再分配内存，成本与前缀长度无关
+        message_.data = kGreeting;
+        message_.data.reserve(message_.data.size() + cpp_pubsub::kMaxSuffix);
+
+        // 创建一个定时器，每 1ms 触发一次 timer_callback() 方法
+        timer_ = this->create_wall_timer(
+            std::chrono::milliseconds(1), std::bind(&Talker::timer_callback, this));
+    }
+
+    bool pool_enabled() const { return pool_.enabled; }
+
+private:
+    // 定时器回调函数，每次触发都会执行
+    void timer_callback() {
+        if (!adaptive_->admit()) {
+            return;  // 自适应模式下降频：跳过这次发布
+        }
+        if (in_place_) {
+            // 原地改写后缀（格式与 concat 模式相同："<时间戳> <序号>"），实时模式下不打印日志
+            cpp_pubsub::write_suffix(message_.data, sizeof(kGreeting) - 1,
+                static_cast<uint64_t>(this->get_clock()->now().nanoseconds()), count_++);
+            if (!realtime_.enabled) {
+                RCLCPP_INFO(this->get_logger(), "Publishing: '%s'", message_.data.c_str());
+            }
+            publisher_->publish(message_);
+            tutorial_utils::StartupProfiler::instance().finish("first_publish", this->get_logger());
+            return;
+        }
+
+        auto message = std_msgs::msg::String();  // 创建 String 类型的消息对象
+
+        // 生成消息内容，包含 "Hello, world" 和当前时间戳的后两位（纳秒）以及 count_ 计数器
+        // 计数器用空格分隔放在最后，订阅端据此解析序号检测丢包
+        message.data = kGreeting
+            + std::to_string(this->get_clock()->now().nanoseconds() % 100)  // 当前 ROS 时间戳的最后两位纳秒
+            + " " + std::to_string(count_++);  // 计数器，每次发送递增
+
+        // 打印日志，显示当前发布的消息内容
+        RCLCPP_INFO(this->get_logger(), "Publishing: '%s'", message.data.c_str());
+
+        // 通过发布者发布消息
+        publisher_->publish(message);
+        tutorial_utils::StartupProfiler::instance().finish("first_publish", this->get_logger());
+    }
+
+    rclcpp::TimerBase::SharedPtr timer_;  // 定时器指针，每 1ms 触发一次回调函数
+    rclcpp::TimerBase::SharedPtr pool_stats_timer_;  // 周期打印内存池计数
+    rclcpp::Publisher<std_msgs::msg::String, tutorial_utils::PoolAlloc>::SharedPtr publisher_;  // 发布者指针
+    std_msgs::msg::String message_;  // in_place 模式下复用的消息
+    bool in_place_;  // 消息构造方式
+    std::unique_ptr<cpp_pubsub::AdaptivePublishRate> adaptive_;  // 自适应发布频率
+    tutorial_utils::RealtimeOptions realtime_;  // 实时模式参数
+    tutorial_utils::PoolOptions pool_;  // 内存池参数
+    size_t count_;  // 计数变量，用于生成不同的消息
+};
+
+}  // namespace cpp_pubsub
+
+#endif  // CPP_PUBSUB__TALKER_HPP_
@@ -0,0 +1,58 @@
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, OpaqueFunction
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+
+
+# N talkers x M listeners split evenly over several scaling_harness processes; each process
+# prints its own "scaling:" line (listener-side discovery/latency, process RSS and CPU).
+# ros2 launch cpp_pubsub scaling_launch.py talkers:=100 listeners:=100 processes:=4 topology:=shared
+def split(total, parts, index):
+    base, extra = divmod(total, parts)
+    offset = index * base + min(index, extra)
+    return offset, base + (1 if index < extra else 0)
+
+
+def launch_setup(context):
+    def arg(name):
+        return LaunchConfiguration(name).perform(context)
+
+    talkers = int(arg('talkers'))
+    listeners = int(arg('listeners'))
+    processes = max(int(arg('processes')), 1)
+    nodes = []
+    for k in range(processes):
+        talker_offset, talker_count = split(talkers, processes, k)
+        listener_offset, listener_count = split(listeners, processes, k)
+        nodes.append(Node(
+            package='cpp_pubsub',
+            executable='scaling_harness',
+            name='scaling_harness_{}'.format(k),
+            output='screen',
+            parameters=[{
+                'talkers': talker_count,
+                'listeners': listener_count,
+                'talker_offset': talker_offset,
+                'listener_offset': listener_offset,
+                'total_talkers': talkers,
+                'total_listeners': listeners,
+                'topology': arg('topology'),
+                'rate_hz': float(arg('rate_hz')),
+                'duration_s': float(arg('duration_s')),
+                'threads': int(arg('threads')),
+            }],
+        ))
+    return nodes
+
+
+def generate_launch_description():
+    return LaunchDescription([
+        DeclareLaunchArgument('talkers', default_value='10'),
+        DeclareLaunchArgument('listeners', default_value='10'),
+        DeclareLaunchArgument('processes', default_value='2'),
+        DeclareLaunchArgument('topology', default_value='shared', description='shared or disjoint'),
+        DeclareLaunchArgument('rate_hz', default_value='100.0'),
+        DeclareLaunchArgument('duration_s', default_value='10.0'),
+        DeclareLaunchArgument('threads', default_value='1'),
+        OpaqueFunction(function=launch_setup),
+    ])
@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+# Sweep scaling_harness over graph sizes and collect its "scaling:" lines into a CSV.
+# Each size runs N talkers x N listeners in one process, for both topologies:
+#   shared    all talkers and listeners on one topic (N x N matched pairs)
+#   disjoint  one topic per talker/listener pair
+#
+# ros2 run cpp_pubsub scaling_sweep.sh [sizes] [duration_s] [out.csv]
+# ros2 run cpp_pubsub scaling_sweep.sh "1 10 50 100 200" 5 scaling.csv
+set -u
+
+SIZES=${1:-"1 10 50 100"}
+DURATION=${2:-5}
+OUT=${3:-scaling.csv}
+HARNESS=$(ros2 pkg prefix cpp_pubsub)/lib/cpp_pubsub/scaling_harness
+
+# to_csv <header|row>: turn "scaling: k1=v1 k2=v2 ..." into "k1,k2,..." or "v1,v2,..."
+to_csv() {
+  sed 's/^.*scaling: //' | tr ' ' '\n' | awk -F= -v what="$1" '
+    { out = out (NR > 1 ? "," : "") (what == "header" ? $1 : $2) }
+    END { print out }'
+}
+
+: > "$OUT"
+for topology in shared disjoint; do
+  for n in $SIZES; do
+    line=$("$HARNESS" --ros-args -p talkers:="$n" -p listeners:="$n" -p topology:="$topology" \
+      -p duration_s:="$DURATION" 2>/dev/null | grep -m1 '^scaling:')
+    if [ -z "$line" ]; then
+      echo "no result for topology=$topology n=$n" >&2
+      continue
+    fi
+    echo "$line"
+    if [ ! -s "$OUT" ]; then
+      echo "$line" | to_csv header >> "$OUT"
+    fi
+    echo "$line" | to_csv row >> "$OUT"
+  done
+done
+echo "wrote $OUT"
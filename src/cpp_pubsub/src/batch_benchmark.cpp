@@ -0,0 +1,235 @@
+// batch_benchmark：Num 批量发布（num_batcher.hpp）的延迟-吞吐曲线。
+// 同一进程里一个发布节点和一个订阅节点（不开 intra-process，走 rmw），各用一个执行器线程。
+// 发布端每 1 ms 定时器产生 rate_hz / 1000 个值（突发），对每个 batch 大小测 duration_s 秒：
+//  - items_per_s / frames_per_s：订阅端实际收到的值和帧
+//  - cpu_us_per_item：测量窗口内进程 user+sys 时间 / 收到的值
+//  - latency_us p50 / p99 / max：值进入批量缓冲（add）到订阅端逐条回调，包含攒批等待
+//  - frame_age_us p50 / p99：每帧收到时距帧内第一个值进入缓冲（NumArray.oldest_stamp_ns）的时间，
+//    即每帧里等得最久的那个值的延迟；batch 0 时为 0
+// batch 0 表示不批量，直接发布 Num，作为基线。每个 batch 大小打印一行 "batch: key=value ..."。
+//
+// ros2 run cpp_pubsub batch_benchmark --ros-args -p rate_hz:=20000.0 -p max_delay_us:=5000
+// ros2 run cpp_pubsub batch_benchmark --ros-args -p batch_sizes:="[0, 1, 8, 64]"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "tutorial_interfaces/msg/num.hpp"
+#include "cpp_pubsub/num_batcher.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+int64_t steady_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+double cpu_seconds()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+double percentile(std::vector<double> & values, double q)
+{
+  if (values.empty()) {
+    return 0.0;
+  }
+  size_t i = std::min(values.size() - 1, static_cast<size_t>(q * static_cast<double>(values.size() - 1) + 0.5));
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(i), values.end());
+  return values[i];
+}
+
+// 两个节点共享的测量状态：add_ns[v] 是值 v 进入缓冲的时刻，订阅端据此算逐条延迟
+struct Run
+{
+  explicit Run(size_t capacity)
+  : add_ns(capacity) {}
+
+  std::vector<std::atomic<int64_t>> add_ns;
+  std::atomic<bool> measuring{false};
+  std::atomic<uint64_t> received{0};
+  std::atomic<uint64_t> frames{0};
+  std::vector<double> latency_us;  // 只由订阅端执行器线程写
+  std::vector<double> frame_age_us;  // 同上
+};
+
+struct Result
+{
+  double items_per_s = 0.0;
+  double frames_per_s = 0.0;
+  double cpu_us_per_item = 0.0;
+  double p50 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+  double frame_age_p50 = 0.0;
+  double frame_age_p99 = 0.0;
+  double loss = 0.0;
+};
+
+Result run_point(
+  int64_t batch, double rate_hz, std::chrono::microseconds max_delay, double duration_s)
+{
+  const size_t per_tick = std::max<size_t>(1, static_cast<size_t>(rate_hz / 1000.0 + 0.5));
+  // 预热 0.5 s + 测量 + 余量，值超出容量后停止产生
+  const size_t capacity = static_cast<size_t>(static_cast<double>(per_tick) * 1000.0 * (duration_s + 2.0));
+  Run run(capacity);
+  run.latency_us.reserve(capacity);
+  run.frame_age_us.reserve(capacity);
+
+  auto suffix = std::to_string(batch);
+  auto pub_node = std::make_shared<rclcpp::Node>("batch_benchmark_pub_" + suffix);
+  auto sub_node = std::make_shared<rclcpp::Node>("batch_benchmark_sub_" + suffix);
+  const std::string topic = "batch_benchmark";
+  const auto qos = rclcpp::QoS(1000);
+
+  auto on_item = [&run](int64_t value) {
+      if (value < 0 || static_cast<size_t>(value) >= run.add_ns.size()) {
+        return;
+      }
+      int64_t added = run.add_ns[static_cast<size_t>(value)].load(std::memory_order_acquire);
+      if (added == 0 || !run.measuring.load(std::memory_order_relaxed)) {
+        return;
+      }
+      run.received.fetch_add(1, std::memory_order_relaxed);
+      run.latency_us.push_back(static_cast<double>(steady_ns() - added) / 1e3);
+    };
+
+  // 发布端
+  std::unique_ptr<cpp_pubsub::NumBatchPublisher> batcher;
+  rclcpp::Publisher<tutorial_interfaces::msg::Num>::SharedPtr publisher;
+  rclcpp::Subscription<tutorial_interfaces::msg::Num>::SharedPtr subscription;
+  rclcpp::Subscription<tutorial_interfaces::msg::NumArray>::SharedPtr batch_subscription;
+  if (batch > 0) {
+    batcher = std::make_unique<cpp_pubsub::NumBatchPublisher>(
+      *pub_node, topic, static_cast<size_t>(batch), max_delay, qos);
+    batch_subscription = sub_node->create_subscription<tutorial_interfaces::msg::NumArray>(
+      cpp_pubsub::num_batch_topic(topic), qos,
+      [&run, &on_item](const tutorial_interfaces::msg::NumArray::SharedPtr frame) {
+        if (run.measuring.load(std::memory_order_relaxed)) {
+          run.frames.fetch_add(1, std::memory_order_relaxed);
+          run.frame_age_us.push_back(
+            static_cast<double>(cpp_pubsub::system_now_ns() - frame->oldest_stamp_ns) / 1e3);
+        }
+        for (auto value : frame->nums) {
+          on_item(value);
+        }
+      });
+  } else {
+    publisher = pub_node->create_publisher<tutorial_interfaces::msg::Num>(topic, qos);
+    subscription = sub_node->create_subscription<tutorial_interfaces::msg::Num>(
+      topic, qos, [&run, &on_item](const tutorial_interfaces::msg::Num::SharedPtr msg) {
+        if (run.measuring.load(std::memory_order_relaxed)) {
+          run.frames.fetch_add(1, std::memory_order_relaxed);
+        }
+        on_item(msg->num);
+      });
+  }
+  std::atomic<uint64_t> produced{0};
+  std::atomic<uint64_t> produced_start{0};
+  auto producer = pub_node->create_wall_timer(
+    1ms, [&]() {
+      for (size_t i = 0; i < per_tick; ++i) {
+        uint64_t value = produced.load(std::memory_order_relaxed);
+        if (value + 1 >= run.add_ns.size()) {
+          return;
+        }
+        // 值从 1 开始，0 留给"未记录"
+        run.add_ns[value + 1].store(steady_ns(), std::memory_order_release);
+        if (batcher) {
+          batcher->add(static_cast<int64_t>(value + 1));
+        } else {
+          tutorial_interfaces::msg::Num msg;
+          msg.num = static_cast<int64_t>(value + 1);
+          publisher->publish(msg);
+        }
+        produced.store(value + 1, std::memory_order_relaxed);
+      }
+    });
+
+  rclcpp::executors::SingleThreadedExecutor pub_executor;
+  rclcpp::executors::SingleThreadedExecutor sub_executor;
+  pub_executor.add_node(pub_node);
+  sub_executor.add_node(sub_node);
+  std::thread pub_thread([&pub_executor]() {pub_executor.spin();});
+  std::thread sub_thread([&sub_executor]() {sub_executor.spin();});
+
+  // 预热：等待匹配，并让缓冲和 DDS 历史进入稳态
+  std::this_thread::sleep_for(500ms);
+  double cpu_start = cpu_seconds();
+  auto window_start = Clock::now();
+  produced_start = produced.load();
+  run.measuring = true;
+  std::this_thread::sleep_for(std::chrono::duration<double>(duration_s));
+  run.measuring = false;
+  uint64_t produced_window = produced.load() - produced_start;
+  double cpu = cpu_seconds() - cpu_start;
+  double window_s = std::chrono::duration<double>(Clock::now() - window_start).count();
+
+  pub_executor.cancel();
+  sub_executor.cancel();
+  pub_thread.join();
+  sub_thread.join();
+
+  Result result;
+  uint64_t received = run.received.load();
+  result.items_per_s = static_cast<double>(received) / window_s;
+  result.frames_per_s = static_cast<double>(run.frames.load()) / window_s;
+  result.cpu_us_per_item = received > 0 ? cpu * 1e6 / static_cast<double>(received) : 0.0;
+  result.max = run.latency_us.empty() ? 0.0 : *std::max_element(run.latency_us.begin(), run.latency_us.end());
+  result.p50 = percentile(run.latency_us, 0.5);
+  result.p99 = percentile(run.latency_us, 0.99);
+  result.frame_age_p50 = percentile(run.frame_age_us, 0.5);
+  result.frame_age_p99 = percentile(run.frame_age_us, 0.99);
+  // 窗口边界上还在缓冲里的值会算作丢失，最多一帧
+  result.loss = produced_window > received ?
+    static_cast<double>(produced_window - received) / static_cast<double>(produced_window) : 0.0;
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<rclcpp::Node>("batch_benchmark");
+  auto batch_sizes = node->declare_parameter<std::vector<int64_t>>(
+    "batch_sizes", std::vector<int64_t>{0, 1, 2, 4, 8, 16, 32, 64, 128});
+  auto rate_hz = node->declare_parameter<double>("rate_hz", 10000.0);
+  auto max_delay_us = node->declare_parameter<int>("max_delay_us", 10000);
+  auto duration_s = node->declare_parameter<double>("duration_s", 3.0);
+
+  for (auto batch : batch_sizes) {
+    if (!rclcpp::ok()) {
+      break;
+    }
+    auto r = run_point(batch, rate_hz, std::chrono::microseconds(max_delay_us), duration_s);
+    std::printf(
+      "batch: max_items=%ld rate_hz=%.0f max_delay_us=%d items_per_s=%.0f frames_per_s=%.0f "
+      "cpu_us_per_item=%.3f latency_us_p50=%.1f latency_us_p99=%.1f latency_us_max=%.1f "
+      "frame_age_us_p50=%.1f frame_age_us_p99=%.1f loss=%.5f\n",
+      static_cast<long>(batch), rate_hz, max_delay_us, r.items_per_s, r.frames_per_s,
+      r.cpu_us_per_item, r.p50, r.p99, r.max, r.frame_age_p50, r.frame_age_p99, r.loss);
+    std::fflush(stdout);
+  }
+  rclcpp::shutdown();
+  return 0;
+}
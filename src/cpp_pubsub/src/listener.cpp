@@ -1,36 +1,22 @@
 // 监听器（Subscriber）节点实现，订阅 "chatter" 话题，并在接收到消息时打印输出。
+// 按发布者 GID 跟踪消息末尾的序号，丢包/乱序/重复统计周期发布到 "diagnostics" 话题：
+// ros2 topic echo /diagnostics
+// 同一窗口的消息年龄和丢包率作为反馈发布到 "chatter/rate_feedback"，供 talker 自适应调整频率。
+// 模拟处理不过来：-p throttle.work_us:=3000（每条消息忙等 3ms）
 
 #include <memory>
 #include "rclcpp/rclcpp.hpp"       // ROS 2 C++ 节点库
-#include "std_msgs/msg/string.hpp" // ROS 2 标准消息类型（std_msgs::msg::String）
-
-// 定义 Listener 类，继承自 rclcpp::Node
-class Listener : public rclcpp::Node {
-public:
-    // 构造函数：创建一个名为 "listener" 的 ROS 2 节点
-    Listener() : Node("listener") {
-        // 创建订阅者，订阅 "chatter" 话题，队列大小设为 10
-        subscription_ = this->create_subscription<std_msgs::msg::String>(
-            "chatter", 10, 
-            // 绑定回调函数 topic_callback()，_1 代表回调函数的参数（接收到的消息）
-            std::bind(&Listener::topic_callback, this, std::placeholders::_1));
-    }
-
-private:
-    // 话题回调函数，当收到 "chatter" 话题的消息时被调用
-    void topic_callback(const std_msgs::msg::String::SharedPtr msg) const {
-        // 打印收到的消息内容
-        RCLCPP_INFO(this->get_logger(), "I heard: [%s]", msg->data.c_str());
-    }
-
-    // 订阅者对象（订阅 "chatter" 话题的消息）
-    rclcpp::Subscription<std_msgs::msg::String>::SharedPtr subscription_;
-};
+#include "cpp_pubsub/listener.hpp"                 // Listener 节点
+#include "tutorial_utils/pool_memory_strategy.hpp" // 内存池分配器和执行器内存策略
+#include "tutorial_utils/startup.hpp"              // 启动阶段计时
 
 // 主函数
 int main(int argc, char **argv) {
     rclcpp::init(argc, argv);                    // 初始化 ROS 2
-    rclcpp::spin(std::make_shared<Listener>());  // 运行节点，监听 "chatter" 话题
+    tutorial_utils::startup_mark("init");
+    auto node = std::make_shared<cpp_pubsub::Listener>();
+    tutorial_utils::startup_mark("node");
+    tutorial_utils::spin(node, node->pool_enabled());  // 运行节点，监听 "chatter" 话题
     rclcpp::shutdown();                          // 退出时清理 ROS 2 资源
     return 0;
 }
@@ -1,8 +1,15 @@
+#include <chrono>
 #include <memory>
 
 #include "rclcpp/rclcpp.hpp"
 #include "tutorial_interfaces/msg/num.hpp"     // CHANGE
+#include "cpp_pubsub/num_batcher.hpp"
+#include "cpp_pubsub/rate_feedback.hpp"
+#include "tutorial_utils/pool_memory_strategy.hpp"
+#include "tutorial_utils/sequence_monitor.hpp"
+#include "tutorial_utils/startup.hpp"
 using std::placeholders::_1;
+using std::placeholders::_2;
 
 class MinimalSubscriber : public rclcpp::Node
 {
@@ -10,22 +17,66 @@ public:
   MinimalSubscriber()
   : Node("minimal_subscriber")
   {
-    subscription_ = this->create_subscription<tutorial_interfaces::msg::Num>(          // CHANGE
-      "topic", 10, std::bind(&MinimalSubscriber::topic_callback, this, _1));
+    // pool allocator opt-in (memory.pool:=true)
+    pool_ = tutorial_utils::declare_pool_parameters(*this);
+    pool_stats_timer_ = tutorial_utils::enable_pool(*this, pool_);
+
+    // gap/reorder/duplicate tracking of Num.num per publisher, published on "diagnostics"
+    sequence_monitor_ = std::make_unique<tutorial_utils::SequenceMonitor>(*this, "topic");
+    // age / loss feedback for adaptive publishers on "topic/rate_feedback"
+    feedback_ = std::make_unique<cpp_pubsub::RateFeedbackReporter>(*this, "topic", *sequence_monitor_);
+    // busy-wait per message, to simulate a subscriber that cannot keep up
+    throttle_ = std::chrono::microseconds(this->declare_parameter<int>("throttle.work_us", 0));
+
+    // batch.enabled:=true subscribes to the NumArray frames of a batching talker ("topic/batch")
+    // and unpacks them, so every value still goes through on_num()
+    if (this->declare_parameter<bool>("batch.enabled", false)) {
+      batch_subscription_ = cpp_pubsub::create_num_batch_subscription(
+        *this, "topic", rclcpp::QoS(10), std::bind(&MinimalSubscriber::on_num, this, _1, _2));
+    } else {
+      subscription_ = this->create_subscription<tutorial_interfaces::msg::Num>(          // CHANGE
+        "topic", 10, std::bind(&MinimalSubscriber::topic_callback, this, _1, _2),
+        tutorial_utils::pool_subscription_options());
+    }
   }
 
+  bool pool_enabled() const {return pool_.enabled;}
+
 private:
-  void topic_callback(const tutorial_interfaces::msg::Num::SharedPtr msg) const       // CHANGE
+  void topic_callback(
+    const tutorial_interfaces::msg::Num::SharedPtr msg, const rclcpp::MessageInfo & info)  // CHANGE
+  {
+    on_num(msg->num, info);
+  }
+
+  void on_num(int64_t num, const rclcpp::MessageInfo & info)
   {
-    RCLCPP_INFO(this->get_logger(), "I heard: '%d'", msg->num);              // CHANGE
+    tutorial_utils::StartupProfiler::instance().finish("first_message", this->get_logger());
+    RCLCPP_INFO(this->get_logger(), "I heard: '%ld'", static_cast<long>(num));              // CHANGE
+    sequence_monitor_->on_message(info, static_cast<uint64_t>(num));
+    feedback_->on_message(info);
+    if (throttle_.count() > 0) {
+      auto until = std::chrono::steady_clock::now() + throttle_;
+      while (std::chrono::steady_clock::now() < until) {
+      }
+    }
   }
-  rclcpp::Subscription<tutorial_interfaces::msg::Num>::SharedPtr subscription_;       // CHANGE
+  rclcpp::Subscription<tutorial_interfaces::msg::Num, tutorial_utils::PoolAlloc>::SharedPtr subscription_;  // CHANGE
+  rclcpp::Subscription<tutorial_interfaces::msg::NumArray>::SharedPtr batch_subscription_;
+  rclcpp::TimerBase::SharedPtr pool_stats_timer_;
+  tutorial_utils::PoolOptions pool_;
+  std::unique_ptr<tutorial_utils::SequenceMonitor> sequence_monitor_;
+  std::unique_ptr<cpp_pubsub::RateFeedbackReporter> feedback_;
+  std::chrono::microseconds throttle_;
 };
 
 int main(int argc, char * argv[])
 {
   rclcpp::init(argc, argv);
-  rclcpp::spin(std::make_shared<MinimalSubscriber>());
+  tutorial_utils::startup_mark("init");
+  auto node = std::make_shared<MinimalSubscriber>();
+  tutorial_utils::startup_mark("node");
+  tutorial_utils::spin(node, node->pool_enabled());
   rclcpp::shutdown();
   return 0;
 }
\ No newline at end of file
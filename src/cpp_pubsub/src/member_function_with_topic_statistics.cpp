@@ -5,6 +5,7 @@
 #include "rclcpp/subscription_options.hpp"
 
 #include "std_msgs/msg/string.hpp"
+#include "tutorial_utils/startup.hpp"
 
 class MinimalSubscriberWithTopicStatistics : public rclcpp::Node
 {
@@ -33,6 +34,7 @@ public:
 private:
   void topic_callback(const std_msgs::msg::String::SharedPtr msg) const
   {
+    tutorial_utils::StartupProfiler::instance().finish("first_message", this->get_logger());
     RCLCPP_INFO(this->get_logger(), "I heard: '%s'", msg->data.c_str());
   }
   rclcpp::Subscription<std_msgs::msg::String>::SharedPtr subscription_;
@@ -41,7 +43,10 @@ private:
 int main(int argc, char * argv[])
 {
   rclcpp::init(argc, argv);
-  rclcpp::spin(std::make_shared<MinimalSubscriberWithTopicStatistics>());
+  tutorial_utils::startup_mark("init");
+  auto node = std::make_shared<MinimalSubscriberWithTopicStatistics>();
+  tutorial_utils::startup_mark("node");
+  rclcpp::spin(node);
   rclcpp::shutdown();
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+// payload_build_benchmark：比较 Talker 两种消息构造方式在 16 B 到 1 MB 消息长度下的单次构造开销。
+// concat 每次拼接整个字符串，开销随长度线性增长；in_place 只改写后缀，开销应与长度无关。
+// 只测构造，不含发布（序列化本身仍与长度成正比）。
+//
+// ros2 run cpp_pubsub payload_build_benchmark [每个长度的最短测量时间 ms，默认 200]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "cpp_pubsub/payload_builder.hpp"
+
+using cpp_pubsub::BuildMode;
+using cpp_pubsub::PayloadBuilder;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// 防止编译器把构造优化掉
+volatile size_t g_sink = 0;
+
+// 每次构造的平均耗时（ns），批量执行直到超过 min_ms
+template<size_t Bytes, BuildMode Mode>
+double measure(double min_ms)
+{
+  PayloadBuilder<Bytes, Mode> builder;
+  std::string out;
+  builder.prime(out);
+  uint64_t count = 0;
+  size_t batch = 16;
+  double elapsed_ns = 0.0;
+  uint64_t iterations = 0;
+  while (elapsed_ns < min_ms * 1e6) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < batch; ++i) {
+      builder.build(out, count, count);
+      ++count;
+      g_sink = g_sink + out.size();
+    }
+    elapsed_ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    iterations += batch;
+    if (batch < (1u << 20)) {
+      batch *= 2;
+    }
+  }
+  return elapsed_ns / static_cast<double>(iterations);
+}
+
+template<size_t Bytes>
+void run_size(double min_ms)
+{
+  double concat = measure<Bytes, BuildMode::Concat>(min_ms);
+  double in_place = measure<Bytes, BuildMode::InPlace>(min_ms);
+  std::printf("%10zu %14.1f %14.1f %9.1fx\n", Bytes, concat, in_place, concat / in_place);
+}
+
+template<size_t... Sizes>
+void run_all(double min_ms, std::index_sequence<Sizes...>)
+{
+  (run_size<(size_t{16} << (2 * Sizes))>(min_ms), ...);  // 16 B, 64 B, ..., 1 MB
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  double min_ms = argc > 1 ? std::atof(argv[1]) : 200.0;
+  if (min_ms <= 0.0) {
+    min_ms = 200.0;
+  }
+  std::printf("%10s %14s %14s %10s\n", "bytes", "concat ns", "in_place ns", "speedup");
+  run_all(min_ms, std::make_index_sequence<9>{});
+  return 0;
+}
@@ -0,0 +1,243 @@
+// scaling_harness：在一个进程里组合 N 个 ScalingTalker 和 M 个 ScalingListener（见 scaling_nodes.hpp），
+// 测量随图规模增长的：
+//  - 每个实体的内存（创建前后 RSS 之差 / 实体数）
+//  - 发现时间（从执行器开始 spin 到 listener 匹配到全部发布者的耗时，p50 / max；节点创建耗时另见 create_ms）
+//  - 每条消息的 CPU 时间（测量窗口内进程 user+sys 时间 / 本进程发送和接收的消息数）
+//  - 延迟（source timestamp 到回调，p50 / p99 / max）和丢包
+// 最后打印一行 "scaling: key=value ..."，scripts/scaling_sweep.sh 汇总成 CSV。
+//
+// ros2 run cpp_pubsub scaling_harness --ros-args -p talkers:=50 -p listeners:=50 -p topology:=shared
+// 多进程：launch/scaling_launch.py 按 offset 把 talker 和 listener 分到多个进程，每个进程各自打印一行。
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "cpp_pubsub/scaling_nodes.hpp"
+
+using namespace std::chrono_literals;
+using cpp_pubsub::ScalingListener;
+using cpp_pubsub::ScalingTalker;
+
+namespace
+{
+
+double rss_mb()
+{
+  long pages = 0;
+  long resident = 0;
+  FILE * f = std::fopen("/proc/self/statm", "r");
+  if (f != nullptr) {
+    if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) {
+      resident = 0;
+    }
+    std::fclose(f);
+  }
+  return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+double cpu_seconds()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+template<typename T>
+T percentile(std::vector<T> & values, double q)
+{
+  if (values.empty()) {
+    return T();
+  }
+  size_t i = std::min(values.size() - 1, static_cast<size_t>(q * static_cast<double>(values.size() - 1) + 0.5));
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(i), values.end());
+  return values[i];
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto harness = std::make_shared<rclcpp::Node>("scaling_harness");
+  auto talkers = static_cast<size_t>(std::max(harness->declare_parameter<int>("talkers", 10), 0));
+  auto listeners = static_cast<size_t>(std::max(harness->declare_parameter<int>("listeners", 10), 0));
+  auto topology = harness->declare_parameter<std::string>("topology", "shared");
+  auto topics = static_cast<size_t>(std::max(harness->declare_parameter<int>("topics", 0), 0));
+  auto rate_hz = harness->declare_parameter<double>("rate_hz", 100.0);
+  auto payload_bytes = harness->declare_parameter<int>("payload_bytes", 128);
+  auto duration_s = harness->declare_parameter<double>("duration_s", 10.0);
+  auto discovery_timeout_s = harness->declare_parameter<double>("discovery_timeout_s", 60.0);
+  auto threads = static_cast<size_t>(std::max(harness->declare_parameter<int>("threads", 1), 1));
+  // 每个节点默认带 6 个参数服务和 /parameter_events 发布者；关掉可以看到它们在规模上的代价
+  auto parameter_services = harness->declare_parameter<bool>("parameter_services", true);
+  // 多进程：本进程的 talker / listener 在全局中的起始编号，以及全局 talker 总数（决定每个话题的发布者数量）
+  auto talker_offset = static_cast<size_t>(std::max(harness->declare_parameter<int>("talker_offset", 0), 0));
+  auto listener_offset = static_cast<size_t>(std::max(harness->declare_parameter<int>("listener_offset", 0), 0));
+  auto total_talkers = static_cast<size_t>(
+    std::max(harness->declare_parameter<int>("total_talkers", static_cast<int>(talkers)), 0));
+  auto total_listeners = static_cast<size_t>(
+    std::max(harness->declare_parameter<int>("total_listeners", static_cast<int>(listeners)), 0));
+  if (topology != "shared" && topology != "disjoint") {
+    RCLCPP_ERROR(harness->get_logger(), "topology must be 'shared' or 'disjoint', got '%s'", topology.c_str());
+    rclcpp::shutdown();
+    return 1;
+  }
+  if (topology == "disjoint" && topics == 0) {
+    topics = std::max<size_t>(std::max(total_talkers, total_listeners), 1);
+  }
+  auto topic_of = [&](size_t global_index) {
+      return topology == "shared" ? size_t{0} : global_index % topics;
+    };
+  auto options_for = [&](const std::string & name, std::vector<rclcpp::Parameter> parameters) {
+      rclcpp::NodeOptions options;
+      options.arguments({"--ros-args", "-r", "__node:=" + name});
+      options.parameter_overrides(std::move(parameters));
+      options.start_parameter_services(parameter_services);
+      options.start_parameter_event_publisher(parameter_services);
+      return options;
+    };
+
+  // 1. 创建实体，记录 RSS
+  double rss_start = rss_mb();
+  auto created = std::chrono::steady_clock::now();
+  std::vector<std::shared_ptr<ScalingTalker>> talker_nodes;
+  for (size_t i = 0; i < talkers; ++i) {
+    size_t g = talker_offset + i;
+    talker_nodes.push_back(std::make_shared<ScalingTalker>(options_for(
+        "scaling_talker_" + std::to_string(g),
+        {rclcpp::Parameter("topic", cpp_pubsub::scaling_topic(topic_of(g))),
+          rclcpp::Parameter("rate_hz", rate_hz), rclcpp::Parameter("payload_bytes", payload_bytes)})));
+  }
+  double rss_talkers = rss_mb();
+  std::vector<std::shared_ptr<ScalingListener>> listener_nodes;
+  for (size_t j = 0; j < listeners; ++j) {
+    size_t g = listener_offset + j;
+    size_t topic = topic_of(g);
+    auto expected = cpp_pubsub::scaling_expected_publishers(topology, total_talkers, topics, topic);
+    listener_nodes.push_back(std::make_shared<ScalingListener>(options_for(
+        "scaling_listener_" + std::to_string(g),
+        {rclcpp::Parameter("topic", cpp_pubsub::scaling_topic(topic)),
+          rclcpp::Parameter("expected_publishers", static_cast<int>(expected))})));
+  }
+  double rss_listeners = rss_mb();
+  double create_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - created).count();
+
+  std::unique_ptr<rclcpp::Executor> executor;
+  if (threads > 1) {
+    executor = std::make_unique<rclcpp::executors::MultiThreadedExecutor>(rclcpp::ExecutorOptions(), threads);
+  } else {
+    executor = std::make_unique<rclcpp::executors::SingleThreadedExecutor>();
+  }
+  executor->add_node(harness);
+  for (auto & node : talker_nodes) {
+    executor->add_node(node);
+  }
+  for (auto & node : listener_nodes) {
+    executor->add_node(node);
+  }
+  // 发现时间从这里算起，不含创建其余节点的时间
+  auto spin_start = std::chrono::steady_clock::now();
+  for (auto & node : listener_nodes) {
+    node->start_clock(spin_start);
+  }
+  std::thread spinner([&executor]() {executor->spin();});
+
+  // 2. 等待所有本地 listener 匹配到各自的全部发布者
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(discovery_timeout_s);
+  size_t discovered = 0;
+  std::vector<double> discovery_ms;
+  while (rclcpp::ok()) {
+    discovered = 0;
+    discovery_ms.clear();
+    for (auto & node : listener_nodes) {
+      double ms = 0.0;
+      if (node->discovery(ms)) {
+        ++discovered;
+        discovery_ms.push_back(ms);
+      }
+    }
+    if (discovered == listener_nodes.size() || std::chrono::steady_clock::now() > deadline) {
+      break;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  if (discovered < listener_nodes.size()) {
+    RCLCPP_WARN(
+      harness->get_logger(), "discovery timed out: %zu of %zu listeners matched all publishers",
+      discovered, listener_nodes.size());
+  }
+
+  // 3. 测量窗口：清零预热阶段的统计
+  std::this_thread::sleep_for(500ms);
+  for (auto & node : listener_nodes) {
+    node->take_stats(true);
+  }
+  uint64_t sent_start = 0;
+  for (auto & node : talker_nodes) {
+    sent_start += node->sent();
+  }
+  double cpu_start = cpu_seconds();
+  auto window_start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::duration<double>(duration_s));
+  double cpu = cpu_seconds() - cpu_start;
+  double window_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - window_start).count();
+
+  uint64_t sent = 0;
+  for (auto & node : talker_nodes) {
+    sent += node->sent();
+  }
+  sent -= sent_start;
+  uint64_t received = 0;
+  uint64_t lost = 0;
+  std::vector<float> latency_us;
+  for (auto & node : listener_nodes) {
+    auto stats = node->take_stats(false);
+    received += stats.received;
+    lost += stats.lost;
+    latency_us.insert(latency_us.end(), stats.latency_us.begin(), stats.latency_us.end());
+  }
+  executor->cancel();
+  spinner.join();
+
+  // 4. 汇总
+  double max_latency = latency_us.empty() ? 0.0 : *std::max_element(latency_us.begin(), latency_us.end());
+  double p50_latency = percentile(latency_us, 0.5);
+  double p99_latency = percentile(latency_us, 0.99);
+  double max_discovery = discovery_ms.empty() ? 0.0 : *std::max_element(discovery_ms.begin(), discovery_ms.end());
+  double p50_discovery = percentile(discovery_ms, 0.5);
+  uint64_t handled = sent + received;
+  double loss = received + lost > 0 ? static_cast<double>(lost) / static_cast<double>(received + lost) : 0.0;
+
+  std::printf(
+    "scaling: talkers=%zu listeners=%zu topology=%s topics=%zu rate_hz=%.0f payload_bytes=%d "
+    "threads=%zu parameter_services=%d create_ms=%.1f rss_mb=%.1f "
+    "kb_per_talker=%.1f kb_per_listener=%.1f discovered=%zu/%zu discovery_ms_p50=%.1f "
+    "discovery_ms_max=%.1f sent_per_s=%.0f received_per_s=%.0f loss=%.5f cpu_pct=%.1f "
+    "cpu_us_per_msg=%.2f latency_us_p50=%.1f latency_us_p99=%.1f latency_us_max=%.1f\n",
+    talkers, listeners, topology.c_str(), topology == "shared" ? size_t{1} : topics, rate_hz,
+    payload_bytes, threads, parameter_services ? 1 : 0, create_ms, rss_listeners,
+    talkers > 0 ? (rss_talkers - rss_start) * 1024.0 / static_cast<double>(talkers) : 0.0,
+    listeners > 0 ? (rss_listeners - rss_talkers) * 1024.0 / static_cast<double>(listeners) : 0.0,
+    discovered, listener_nodes.size(), p50_discovery, max_discovery,
+    static_cast<double>(sent) / window_s, static_cast<double>(received) / window_s, loss,
+    cpu / window_s * 100.0, handled > 0 ? cpu * 1e6 / static_cast<double>(handled) : 0.0,
+    p50_latency, p99_latency, max_latency);
+  std::fflush(stdout);
+
+  listener_nodes.clear();
+  talker_nodes.clear();
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,130 @@
+// 规模测试组件的实现，见 include/cpp_pubsub/scaling_nodes.hpp。
+
+#include "cpp_pubsub/scaling_nodes.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include "cpp_pubsub/payload_builder.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+
+namespace cpp_pubsub
+{
+
+ScalingTalker::ScalingTalker(const rclcpp::NodeOptions & options)
+: Node("scaling_talker", options)
+{
+  auto topic = this->declare_parameter<std::string>("topic", scaling_topic(0));
+  auto rate_hz = this->declare_parameter<double>("rate_hz", 100.0);
+  auto payload_bytes = this->declare_parameter<int>("payload_bytes", 128);
+
+  message_.data = make_prefix(static_cast<size_t>(std::max(payload_bytes, 0)));
+  prefix_len_ = message_.data.size();
+  publisher_ = this->create_publisher<std_msgs::msg::String>(topic, 10);
+  auto period = std::chrono::duration<double>(1.0 / (rate_hz > 0.0 ? rate_hz : 100.0));
+  timer_ = this->create_wall_timer(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(period), [this]() {on_timer();});
+}
+
+void ScalingTalker::on_timer()
+{
+  write_suffix(message_.data, prefix_len_, 0, sent_.fetch_add(1, std::memory_order_relaxed));
+  publisher_->publish(message_);
+}
+
+ScalingListener::ScalingListener(const rclcpp::NodeOptions & options)
+: Node("scaling_listener", options)
+{
+  auto topic = this->declare_parameter<std::string>("topic", scaling_topic(0));
+  expected_publishers_ = static_cast<size_t>(
+    std::max(this->declare_parameter<int>("expected_publishers", 1), 0));
+  max_samples_ = static_cast<size_t>(std::max(this->declare_parameter<int>("max_samples", 20000), 0));
+  stats_.latency_us.reserve(max_samples_);
+
+  subscription_ = this->create_subscription<std_msgs::msg::String>(
+    topic, 10,
+    [this](const std_msgs::msg::String::SharedPtr msg, const rclcpp::MessageInfo & info) {
+      on_message(msg, info);
+    });
+  // 每 5ms 检查一次匹配到的发布者数量，发现完成后取消
+  discovery_timer_ = this->create_wall_timer(
+    std::chrono::milliseconds(5), [this]() {check_discovery();});
+}
+
+void ScalingListener::start_clock(Clock::time_point start)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  started_ = start;
+}
+
+void ScalingListener::check_discovery()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_ == Clock::time_point()) {
+      started_ = Clock::now();  // 没有 start_clock：第一次触发时执行器刚开始 spin
+    }
+  }
+  if (subscription_->get_publisher_count() < expected_publishers_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.discovered = true;
+  stats_.discovery_ms = std::chrono::duration<double, std::milli>(Clock::now() - started_).count();
+  discovery_timer_->cancel();
+}
+
+void ScalingListener::on_message(
+  const std_msgs::msg::String::SharedPtr & msg, const rclcpp::MessageInfo & info)
+{
+  const auto & rmw_info = info.get_rmw_message_info();
+  int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+
+  // 消息最后一个空格之后是发布端的序号
+  auto pos = msg->data.rfind(' ');
+  uint64_t seq = pos == std::string::npos ? 0 : std::strtoull(msg->data.c_str() + pos + 1, nullptr, 10);
+  tutorial_utils::SequenceMonitor::Gid gid;
+  std::memcpy(gid.data(), rmw_info.publisher_gid.data, gid.size());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stats_.received++ == 0 && stats_.first_message_ms == 0.0 && started_ != Clock::time_point()) {
+    stats_.first_message_ms = std::chrono::duration<double, std::milli>(Clock::now() - started_).count();
+  }
+  trackers_[gid].on_message(seq);
+  if (rmw_info.source_timestamp > 0 && stats_.latency_us.size() < max_samples_) {
+    stats_.latency_us.push_back(static_cast<float>(now_ns - rmw_info.source_timestamp) / 1000.0f);
+  }
+}
+
+bool ScalingListener::discovery(double & ms)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ms = stats_.discovery_ms;
+  return stats_.discovered;
+}
+
+ScalingListener::Stats ScalingListener::take_stats(bool reset)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t lost = 0;
+  for (const auto & entry : trackers_) {
+    lost += entry.second.counters().lost;
+  }
+  stats_.lost = lost - lost_base_;
+  Stats out = stats_;
+  if (reset) {
+    lost_base_ = lost;
+    stats_.received = 0;
+    stats_.lost = 0;
+    stats_.latency_us.clear();
+  }
+  return out;
+}
+
+}  // namespace cpp_pubsub
+
+RCLCPP_COMPONENTS_REGISTER_NODE(cpp_pubsub::ScalingTalker)
+RCLCPP_COMPONENTS_REGISTER_NODE(cpp_pubsub::ScalingListener)
@@ -3,6 +3,11 @@
 
 #include "rclcpp/rclcpp.hpp"
 #include "tutorial_interfaces/msg/num.hpp"     // CHANGE
+#include "cpp_pubsub/num_batcher.hpp"
+#include "cpp_pubsub/rate_feedback.hpp"
+#include "tutorial_utils/pool_memory_strategy.hpp"
+#include "tutorial_utils/realtime.hpp"
+#include "tutorial_utils/startup.hpp"
 
 using namespace std::chrono_literals;
 
@@ -12,28 +17,77 @@ public:
   MinimalPublisher()
   : Node("minimal_publisher"), count_(0)
   {
-    publisher_ = this->create_publisher<tutorial_interfaces::msg::Num>("topic", 10);    // CHANGE
+    // real-time mode: mlockall, pre-fault heap/stack, SCHED_FIFO and CPU affinity from parameters
+    realtime_ = tutorial_utils::declare_realtime_parameters(*this);
+    // pool allocator opt-in (memory.pool:=true), always on in real-time mode
+    pool_ = tutorial_utils::declare_pool_parameters(*this);
+    if (realtime_.enabled) {
+      tutorial_utils::apply_realtime(realtime_, this->get_logger());
+      pool_.enabled = true;
+    }
+    pool_stats_timer_ = tutorial_utils::enable_pool(*this, pool_);
+
+    // AIMD rate control from subscriber feedback (adaptive.enabled:=true). It only gates how
+    // often a value is produced: with batching on, batch.max_items stays fixed and frames just
+    // fill more slowly (up to batch.max_delay_us) when the rate is cut
+    adaptive_ = std::make_unique<cpp_pubsub::AdaptivePublishRate>(*this, "topic", 1000.0);
+    // batching (batch.max_items > 0): values go out as NumArray frames on "topic/batch",
+    // flushed at max_items values or max_delay_us after the first value of a frame;
+    // the plain Num publisher is only created without batching
+    auto batch_items = this->declare_parameter<int>("batch.max_items", 0);
+    auto batch_delay_us = this->declare_parameter<int>("batch.max_delay_us", 10000);
+    if (batch_items > 0) {
+      batcher_ = std::make_unique<cpp_pubsub::NumBatchPublisher>(
+        *this, "topic", static_cast<size_t>(batch_items), std::chrono::microseconds(batch_delay_us));
+      // subscribers report feedback against the GID of the publisher they actually hear from
+      adaptive_->set_publisher_gid(batcher_->get_gid());
+    } else {
+      publisher_ = this->create_publisher<tutorial_interfaces::msg::Num>(                    // CHANGE
+        "topic", 10, tutorial_utils::pool_publisher_options());
+      adaptive_->set_publisher_gid(publisher_->get_gid());
+    }
     timer_ = this->create_wall_timer(
       1ms, std::bind(&MinimalPublisher::timer_callback, this));
   }
 
+  bool pool_enabled() const {return pool_.enabled;}
+
 private:
   void timer_callback()
   {
+    if (!adaptive_->admit()) {
+      return;
+    }
     auto message = tutorial_interfaces::msg::Num();                               // CHANGE
     message.num = this->count_++;                                        // CHANGE
-    RCLCPP_INFO(this->get_logger(), "Publishing: '%d'", message.num);    // CHANGE
-    publisher_->publish(message);
+    if (!realtime_.enabled) {
+      RCLCPP_INFO(this->get_logger(), "Publishing: '%d'", message.num);    // CHANGE
+    }
+    if (batcher_) {
+      batcher_->add(message.num);
+    } else {
+      publisher_->publish(message);
+    }
+    tutorial_utils::StartupProfiler::instance().finish("first_publish", this->get_logger());
   }
   rclcpp::TimerBase::SharedPtr timer_;
-  rclcpp::Publisher<tutorial_interfaces::msg::Num>::SharedPtr publisher_;         // CHANGE
+  rclcpp::TimerBase::SharedPtr pool_stats_timer_;
+  rclcpp::Publisher<tutorial_interfaces::msg::Num, tutorial_utils::PoolAlloc>::SharedPtr publisher_;  // CHANGE
+  tutorial_utils::RealtimeOptions realtime_;
+  tutorial_utils::PoolOptions pool_;
+  std::unique_ptr<cpp_pubsub::AdaptivePublishRate> adaptive_;
+  std::unique_ptr<cpp_pubsub::NumBatchPublisher> batcher_;
   size_t count_;
 };
 
 int main(int argc, char * argv[])
 {
   rclcpp::init(argc, argv);
-  rclcpp::spin(std::make_shared<MinimalPublisher>());
+  tutorial_utils::startup_mark("init");
+  auto node = std::make_shared<MinimalPublisher>();
+  tutorial_utils::startup_mark("node");
+  // with the pool enabled the executor's wait-set bookkeeping comes from the pool as well
+  tutorial_utils::spin(node, node->pool_enabled());
   rclcpp::shutdown();
   return 0;
-}
\ No newline at end of file
+}
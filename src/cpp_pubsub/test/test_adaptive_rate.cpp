@@ -0,0 +1,120 @@
+// 自适应发布频率的端到端测试：真实的 listener（throttle.work_us 模拟处理不过来）和开启
+// adaptive.enabled 的 talker 在同一个多线程执行器里运行，反馈走完整的路径：
+// listener 的 RateFeedbackReporter -> "chatter/rate_feedback" -> talker 按 GID 过滤的订阅 -> admit()。
+// 稳定后 talker 的实际发布频率应低于 listener 的处理能力，且丢包率有界。
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rcutils/logging.h"
+#include "std_msgs/msg/string.hpp"
+#include "tutorial_interfaces/msg/rate_feedback.hpp"
+#include "cpp_pubsub/listener.hpp"
+#include "cpp_pubsub/talker.hpp"
+
+namespace
+{
+
+constexpr int kWorkUs = 3000;                   // listener 每条消息忙等 3ms
+constexpr double kDrainHz = 1e6 / kWorkUs;      // listener 处理能力的上限（约 333 Hz）
+
+}  // namespace
+
+class AdaptiveRate : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+    // talker 和 listener 每条消息都打印一行 INFO，测试里只保留警告
+    rcutils_logging_set_logger_level("talker", RCUTILS_LOG_SEVERITY_WARN);
+    rcutils_logging_set_logger_level("listener", RCUTILS_LOG_SEVERITY_WARN);
+  }
+  static void TearDownTestCase() {rclcpp::shutdown();}
+};
+
+TEST_F(AdaptiveRate, talker_settles_below_throttled_listener)
+{
+  auto listener = std::make_shared<cpp_pubsub::Listener>(
+    rclcpp::NodeOptions().parameter_overrides({
+      rclcpp::Parameter("throttle.work_us", kWorkUs),
+      rclcpp::Parameter("sequence.window_ms", 100),
+    }));
+  auto talker = std::make_shared<cpp_pubsub::Talker>(
+    rclcpp::NodeOptions().parameter_overrides({
+      rclcpp::Parameter("adaptive.enabled", true),
+      rclcpp::Parameter("adaptive.target_age_ms", 10.0),
+      rclcpp::Parameter("message.build_mode", "in_place"),
+    }));
+
+  // 观察节点：不限速地数 talker 实际发出的消息，并记录 listener 上报的每个窗口的丢包率
+  auto observer = rclcpp::Node::make_shared("adaptive_rate_observer");
+  std::atomic<uint64_t> published{0};
+  auto chatter = observer->create_subscription<std_msgs::msg::String>(
+    "chatter", rclcpp::QoS(1000),
+    [&published](const std_msgs::msg::String::SharedPtr) {++published;});
+  struct Window
+  {
+    std::chrono::steady_clock::time_point at;
+    uint32_t received;
+    double loss_rate;
+  };
+  std::mutex windows_mutex;
+  std::vector<Window> windows;
+  auto feedback = observer->create_subscription<tutorial_interfaces::msg::RateFeedback>(
+    cpp_pubsub::rate_feedback_topic("chatter"), 10,
+    [&](const tutorial_interfaces::msg::RateFeedback::SharedPtr msg) {
+      std::lock_guard<std::mutex> lock(windows_mutex);
+      windows.push_back(Window{std::chrono::steady_clock::now(), msg->received, msg->loss_rate});
+    });
+
+  // 节点的默认回调组互斥，各节点之间可以并行：listener 忙等时 talker 的定时器照常触发
+  rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(), 4);
+  executor.add_node(listener);
+  executor.add_node(talker);
+  executor.add_node(observer);
+  std::thread spinner([&executor]() {executor.spin();});
+
+  // 先以 1 kHz 压垮 listener，给 AIMD 3 s 收敛，再测量 5 s
+  std::this_thread::sleep_for(std::chrono::seconds(3));
+  auto start = std::chrono::steady_clock::now();
+  uint64_t published_start = published.load();
+  std::this_thread::sleep_for(std::chrono::seconds(5));
+  uint64_t published_end = published.load();
+  auto end = std::chrono::steady_clock::now();
+
+  executor.cancel();
+  spinner.join();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  double published_hz = static_cast<double>(published_end - published_start) / seconds;
+  double received = 0.0;
+  double lost = 0.0;
+  size_t measured_windows = 0;
+  for (const auto & window : windows) {
+    if (window.at < start || window.at > end || window.loss_rate >= 1.0) {
+      continue;
+    }
+    // loss_rate = lost / (received + lost)
+    received += window.received;
+    lost += window.received * window.loss_rate / (1.0 - window.loss_rate);
+    ++measured_windows;
+  }
+  double loss = received + lost > 0.0 ? lost / (received + lost) : 1.0;
+
+  std::printf(
+    "adaptive talker: %.0f Hz published (listener drains <= %.0f Hz), loss %.2f%% over %zu windows\n",
+    published_hz, kDrainHz, loss * 100.0, measured_windows);
+  EXPECT_GT(measured_windows, 10u) << "no rate feedback from the listener";
+  EXPECT_LT(published_hz, kDrainHz);         // 从 1 kHz 降到了 listener 的处理能力以下
+  EXPECT_GT(published_hz, 0.25 * kDrainHz);  // 没有退到 adaptive.min_hz
+  EXPECT_LT(loss, 0.05);
+}
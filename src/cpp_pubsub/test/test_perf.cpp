@@ -0,0 +1,140 @@
+// 性能回归门限（ctest 标签 perf）：talker 的消息构造和 listener 的消息分发。
+//  - talker_build_in_place_128 / talker_build_concat_128：PayloadBuilder 两种模式构造一条 128 B 消息
+//  - listener_parse_sequence：listener 回调里的取序号（cpp_pubsub::parse_sequence）和 SequenceTracker 记账
+//  - listener_dispatch_intra_process：进程内通信发布一条 talker 格式的消息，由执行器 spin_some 分发到
+//    订阅回调（经过 rclcpp 的等待集和回调分发，不经过 DDS）
+// 结果与 test/perf_baseline.json 比较，判定规则和环境变量见 tutorial_utils/perf_gate.hpp。
+//
+// 只在 -DPERF_GATE=ON 时构建。在本机重新记录基线：PERF_GATE_UPDATE=1 colcon test --packages-select cpp_pubsub --ctest-args -L perf
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "cpp_pubsub/payload_builder.hpp"
+#include "tutorial_utils/perf_gate.hpp"
+#include "tutorial_utils/sequence_tracker.hpp"
+
+using cpp_pubsub::BuildMode;
+using cpp_pubsub::PayloadBuilder;
+
+namespace
+{
+
+tutorial_utils::PerfGate & gate()
+{
+  static tutorial_utils::PerfGate instance(PERF_BASELINE_PATH);
+  return instance;
+}
+
+volatile uint64_t g_sink = 0;
+
+template<BuildMode Mode>
+void check_build(const std::string & name)
+{
+  PayloadBuilder<128, Mode> builder;
+  std::string data;
+  builder.prime(data);
+  uint64_t count = 0;
+  auto result = tutorial_utils::run_benchmark(
+    name, [&](uint64_t n) {
+      for (uint64_t i = 0; i < n; ++i, ++count) {
+        builder.build(data, count * 7919, count);
+        g_sink = data.size();
+      }
+    });
+  auto verdict = gate().check(result);
+  EXPECT_TRUE(verdict.passed()) << verdict.message;
+}
+
+}  // namespace
+
+class PubsubPerf : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase() {rclcpp::init(0, nullptr);}
+  static void TearDownTestCase() {rclcpp::shutdown();}
+};
+
+TEST_F(PubsubPerf, talker_build)
+{
+  if (gate().disabled()) {
+    return;
+  }
+  check_build<BuildMode::InPlace>("talker_build_in_place_128");
+  check_build<BuildMode::Concat>("talker_build_concat_128");
+}
+
+TEST_F(PubsubPerf, listener_parse_sequence)
+{
+  if (gate().disabled()) {
+    return;
+  }
+  PayloadBuilder<128, BuildMode::InPlace> builder;
+  std::string data;
+  builder.prime(data);
+  tutorial_utils::SequenceTracker tracker;
+  uint64_t count = 0;
+  auto result = tutorial_utils::run_benchmark(
+    "listener_parse_sequence", [&](uint64_t n) {
+      for (uint64_t i = 0; i < n; ++i, ++count) {
+        builder.build(data, count, count);
+        uint64_t seq = 0;
+        if (cpp_pubsub::parse_sequence(data, seq)) {
+          tracker.on_message(seq);
+        }
+      }
+    });
+  EXPECT_EQ(0u, tracker.counters().lost);
+  auto verdict = gate().check(result);
+  EXPECT_TRUE(verdict.passed()) << verdict.message;
+}
+
+TEST_F(PubsubPerf, listener_dispatch_intra_process)
+{
+  if (gate().disabled()) {
+    return;
+  }
+  auto node = std::make_shared<rclcpp::Node>(
+    "pubsub_perf", rclcpp::NodeOptions().use_intra_process_comms(true));
+  tutorial_utils::SequenceTracker tracker;
+  uint64_t received = 0;
+  auto subscription = node->create_subscription<std_msgs::msg::String>(
+    "perf_chatter", 10,
+    [&](const std_msgs::msg::String::SharedPtr msg) {
+      uint64_t seq = 0;
+      if (cpp_pubsub::parse_sequence(msg->data, seq)) {
+        tracker.on_message(seq);
+      }
+      ++received;
+    });
+  auto publisher = node->create_publisher<std_msgs::msg::String>("perf_chatter", 10);
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+
+  PayloadBuilder<128, BuildMode::InPlace> builder;
+  std::string data;
+  builder.prime(data);
+  uint64_t count = 0;
+  auto result = tutorial_utils::run_benchmark(
+    "listener_dispatch_intra_process", [&](uint64_t n) {
+      for (uint64_t i = 0; i < n; ++i, ++count) {
+        builder.build(data, count, count);
+        auto msg = std::make_unique<std_msgs::msg::String>();
+        msg->data = data;
+        publisher->publish(std::move(msg));
+        // 进程内通信：spin_some 在消息入队后的第一轮就能取到；没取到时继续等
+        while (received <= count && rclcpp::ok()) {
+          executor.spin_some();
+        }
+      }
+    });
+  EXPECT_EQ(count, received);
+  EXPECT_EQ(0u, tracker.counters().lost);
+  auto verdict = gate().check(result);
+  EXPECT_TRUE(verdict.passed()) << verdict.message;
+}
@@ -0,0 +1,28 @@
+#ifndef CPP_SRVCLI__ADD_TWO_INTS_HPP_
+#define CPP_SRVCLI__ADD_TWO_INTS_HPP_
+
+// The add_two_ints handler of add_two_ints_server, kept in a header so the perf test
+// (test/test_perf.cpp) dispatches exactly the callback the server registers.
+
+#include <memory>
+
+#include "rclcpp/rclcpp.hpp"
+#include "example_interfaces/srv/add_two_ints.hpp"
+#include "tutorial_utils/startup.hpp"
+
+namespace cpp_srvcli
+{
+
+inline void add(const std::shared_ptr<example_interfaces::srv::AddTwoInts::Request> request,
+               std::shared_ptr<example_interfaces::srv::AddTwoInts::Response> response)
+{
+  response->sum = request->a + request->b;
+  tutorial_utils::StartupProfiler::instance().finish("first_request", rclcpp::get_logger("rclcpp"));
+  RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "Incoming request\na: %ld" " b: %ld",
+                request->a, request->b);
+  RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "sending back response: [%ld]", (long int)response->sum);
+}
+
+}  // namespace cpp_srvcli
+
+#endif  // CPP_SRVCLI__ADD_TWO_INTS_HPP_
@@ -0,0 +1,295 @@
+#ifndef CPP_SRVCLI__SERVICE_MULTIPLEXER_HPP_
+#define CPP_SRVCLI__SERVICE_MULTIPLEXER_HPP_
+
+// Many services on one node, handled on a shared WorkerPool:
+//  - DeferredService takes the request off the executor without answering it; the response is
+//    sent from the worker with rcl_send_response once the handler is done, so a slow handler
+//    occupies a worker, not the executor.
+//  - ServiceLane caps how many handlers of one service run at once and queues the rest in a
+//    bounded backlog, recording queue and handler times.
+//  - A request that finds the backlog full is answered at once with a reject response (default
+//    constructed, or filled in by the optional `reject` callback), so clients never wait for a
+//    response that will not come, and counted in LaneStats::rejected. A response without a status
+//    field cannot tell the client it was rejected: read the count from the server instead.
+//
+//   ServiceMultiplexer mux(*node, 4, 1024);
+//   mux.add_service<example_interfaces::srv::AddTwoInts>(
+//     "add_two_ints", 2, [](const auto & req, auto & res) {res.sum = req.a + req.b;});
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "cpp_srvcli/service_trace.hpp"
+#include "cpp_srvcli/worker_pool.hpp"
+
+namespace cpp_srvcli
+{
+
+struct LaneStats
+{
+  std::string name;
+  size_t max_concurrency = 0;
+  uint64_t received = 0;
+  uint64_t completed = 0;
+  uint64_t rejected = 0;   // backlog full, answered with the reject response
+  size_t running = 0;
+  size_t queued = 0;
+  size_t max_queued = 0;
+  double queue_wait_ms_total = 0.0;  // enqueue -> handler start
+  double queue_wait_ms_max = 0.0;
+  double handler_ms_total = 0.0;
+  double handler_ms_max = 0.0;
+};
+
+class ServiceLane
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  ServiceLane(std::string name, WorkerPool & pool, size_t max_concurrency, size_t max_queue)
+  : pool_(pool), max_queue_(max_queue)
+  {
+    stats_.name = std::move(name);
+    stats_.max_concurrency = std::max<size_t>(max_concurrency, 1);
+  }
+
+  // Run `work` on the pool now if the lane has a free slot, else queue it.
+  // Returns false when the backlog is full and the work was not queued.
+  bool dispatch(std::function<void()> work)
+  {
+    Pending pending{std::move(work), Clock::now()};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.received;
+      if (stats_.running >= stats_.max_concurrency) {
+        if (backlog_.size() >= max_queue_) {
+          ++stats_.rejected;
+          return false;
+        }
+        backlog_.push_back(std::move(pending));
+        stats_.max_queued = std::max(stats_.max_queued, backlog_.size());
+        return true;
+      }
+      ++stats_.running;
+    }
+    submit(std::move(pending));
+    return true;
+  }
+
+  LaneStats stats() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LaneStats copy = stats_;
+    copy.queued = backlog_.size();
+    return copy;
+  }
+
+private:
+  struct Pending
+  {
+    std::function<void()> work;
+    Clock::time_point enqueued;
+  };
+
+  void submit(Pending pending)
+  {
+    auto shared = std::make_shared<Pending>(std::move(pending));
+    pool_.submit([this, shared]() {run(*shared);});
+  }
+
+  void run(Pending & pending)
+  {
+    auto start = Clock::now();
+    pending.work();
+    auto end = Clock::now();
+    double wait_ms = std::chrono::duration<double, std::milli>(start - pending.enqueued).count();
+    double handler_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    Pending next;
+    bool has_next = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.completed;
+      stats_.queue_wait_ms_total += wait_ms;
+      stats_.queue_wait_ms_max = std::max(stats_.queue_wait_ms_max, wait_ms);
+      stats_.handler_ms_total += handler_ms;
+      stats_.handler_ms_max = std::max(stats_.handler_ms_max, handler_ms);
+      if (backlog_.empty()) {
+        --stats_.running;
+      } else {
+        // hand the slot straight to the next queued request
+        next = std::move(backlog_.front());
+        backlog_.pop_front();
+        has_next = true;
+      }
+    }
+    if (has_next) {
+      submit(std::move(next));
+    }
+  }
+
+  WorkerPool & pool_;
+  size_t max_queue_;
+  mutable std::mutex mutex_;
+  std::deque<Pending> backlog_;
+  LaneStats stats_;
+};
+
+// rclcpp::Service whose requests are handed to `handler` instead of being answered inline;
+// the response is sent later with send_deferred(), from any thread.
+template<typename ServiceT>
+class DeferredService : public rclcpp::Service<ServiceT>
+{
+public:
+  using Request = typename ServiceT::Request;
+  using Response = typename ServiceT::Response;
+  using Handler = std::function<void(std::shared_ptr<rmw_request_id_t>, std::shared_ptr<Request>)>;
+
+  DeferredService(
+    std::shared_ptr<rcl_node_t> node_handle, const std::string & service_name,
+    rcl_service_options_t & options)
+  : rclcpp::Service<ServiceT>(node_handle, service_name, unused_callback(), options),
+    service_id_(ServiceTracer::instance().register_service(this->get_service_name()))
+  {
+  }
+
+  void set_handler(Handler handler) {handler_ = std::move(handler);}
+
+  void handle_request(
+    std::shared_ptr<rmw_request_id_t> request_header, std::shared_ptr<void> request) override
+  {
+    trace(TraceEvent::ServerReceived, service_id_, request_header->sequence_number);
+    handler_(std::move(request_header), std::static_pointer_cast<Request>(request));
+  }
+
+  rcl_ret_t send_deferred(rmw_request_id_t & request_header, Response & response)
+  {
+    rcl_ret_t ret = rcl_send_response(this->get_service_handle().get(), &request_header, &response);
+    trace(TraceEvent::ResponseSent, service_id_, request_header.sequence_number);
+    return ret;
+  }
+
+  uint32_t service_id() const {return service_id_;}
+
+private:
+  // the base class requires a callback; handle_request above never calls it
+  static rclcpp::AnyServiceCallback<ServiceT> unused_callback()
+  {
+    rclcpp::AnyServiceCallback<ServiceT> callback;
+    callback.set([](const std::shared_ptr<Request>, std::shared_ptr<Response>) {});
+    return callback;
+  }
+
+  Handler handler_;
+  uint32_t service_id_;
+};
+
+class ServiceMultiplexer
+{
+public:
+  ServiceMultiplexer(rclcpp::Node & node, size_t threads, size_t max_queue)
+  : node_(node), max_queue_(max_queue), pool_(threads)
+  {
+  }
+
+  // Register `name`; handler(const Request &, Response &) runs on the pool with at most
+  // max_concurrency instances at a time.
+  template<typename ServiceT, typename HandlerT>
+  void add_service(const std::string & name, size_t max_concurrency, HandlerT handler)
+  {
+    add_service<ServiceT>(
+      name, max_concurrency, std::move(handler),
+      [](const typename ServiceT::Request &, typename ServiceT::Response &) {});
+  }
+
+  // Same; reject(const Request &, Response &) fills the response sent, from the executor thread,
+  // when the backlog is full (for services whose response has a status field to set).
+  template<typename ServiceT, typename HandlerT, typename RejectT>
+  void add_service(const std::string & name, size_t max_concurrency, HandlerT handler, RejectT reject)
+  {
+    using Service = DeferredService<ServiceT>;
+    using Request = typename ServiceT::Request;
+    using Response = typename ServiceT::Response;
+
+    lanes_.push_back(std::make_unique<ServiceLane>(name, pool_, max_concurrency, max_queue_));
+    ServiceLane * lane = lanes_.back().get();
+
+    rcl_service_options_t options = rcl_service_get_default_options();
+    options.qos = rmw_qos_profile_services_default;
+    auto service = std::make_shared<Service>(
+      node_.get_node_base_interface()->get_shared_rcl_node_handle(), name, options);
+    std::weak_ptr<Service> weak_service = service;
+    auto logger = node_.get_logger();
+    uint32_t service_id = service->service_id();
+    service->set_handler(
+      [lane, weak_service, handler, reject, logger, service_id](
+        std::shared_ptr<rmw_request_id_t> header, std::shared_ptr<Request> request) {
+        bool accepted = lane->dispatch(
+          [weak_service, handler, logger, service_id, header, request]() {
+            Response response;
+            trace(TraceEvent::HandlerStart, service_id, header->sequence_number);
+            handler(*request, response);
+            trace(TraceEvent::HandlerEnd, service_id, header->sequence_number);
+            auto service = weak_service.lock();
+            if (!service) {
+              return;
+            }
+            if (service->send_deferred(*header, response) != RCL_RET_OK) {
+              RCLCPP_ERROR(
+                logger, "failed to send response for '%s': %s", service->get_service_name(),
+                rcl_get_error_string().str);
+              rcl_reset_error();
+            }
+          });
+        if (!accepted) {
+          RCLCPP_WARN_ONCE(logger, "request backlog full, rejecting requests");
+          auto service = weak_service.lock();
+          if (!service) {
+            return;
+          }
+          Response response;
+          reject(*request, response);
+          if (service->send_deferred(*header, response) != RCL_RET_OK) {
+            RCLCPP_ERROR(
+              logger, "failed to send reject response for '%s': %s", service->get_service_name(),
+              rcl_get_error_string().str);
+            rcl_reset_error();
+          }
+        }
+      });
+    node_.get_node_services_interface()->add_service(service, nullptr);
+    services_.push_back(service);
+  }
+
+  std::vector<LaneStats> stats() const
+  {
+    std::vector<LaneStats> out;
+    out.reserve(lanes_.size());
+    for (const auto & lane : lanes_) {
+      out.push_back(lane->stats());
+    }
+    return out;
+  }
+
+  size_t threads() const {return pool_.size();}
+
+private:
+  rclcpp::Node & node_;
+  size_t max_queue_;
+  std::vector<rclcpp::ServiceBase::SharedPtr> services_;
+  std::vector<std::unique_ptr<ServiceLane>> lanes_;
+  WorkerPool pool_;  // declared last: joined (and drained) before the lanes it runs go away
+};
+
+}  // namespace cpp_srvcli
+
+#endif  // CPP_SRVCLI__SERVICE_MULTIPLEXER_HPP_
@@ -0,0 +1,219 @@
+#ifndef CPP_SRVCLI__SERVICE_TRACE_HPP_
+#define CPP_SRVCLI__SERVICE_TRACE_HPP_
+
+// Opt-in binary trace of service request/response hops.
+//
+// When SRVCLI_TRACE_DIR is set, each process appends fixed-size records to
+// $SRVCLI_TRACE_DIR/<executable>-<pid>.srvtrace; nothing is recorded otherwise.
+// Timestamps are CLOCK_MONOTONIC, so files written by client and server processes on the same
+// machine can be merged by service_trace_analyzer. Records are keyed by (service, sequence):
+// the sequence number is the client's request sequence number (rmw_request_id_t on the server,
+// a per-client counter starting at 1 on the client), so one client per service is assumed.
+
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cpp_srvcli
+{
+
+enum class TraceEvent : uint8_t
+{
+  RequestCreated = 0,  // client: service available, request about to be sent
+  RequestSent,         // client: async_send_request returned
+  ServerReceived,      // server: executor handed the request to the service
+  HandlerStart,
+  HandlerEnd,
+  ResponseSent,        // server: rcl_send_response returned
+  ClientReceived,      // client: response callback entered
+  Count,
+  ServiceName = 255,   // not a hop: timestamp_ns/sequence hold 16 characters of the name,
+                       // reserved[0] which 16-character chunk (names longer than 16 take several)
+};
+
+inline const char * trace_event_name(TraceEvent event)
+{
+  static const char * const names[] = {
+    "request_created", "request_sent", "server_received", "handler_start", "handler_end",
+    "response_sent", "client_received"};
+  auto i = static_cast<size_t>(event);
+  return i < static_cast<size_t>(TraceEvent::Count) ? names[i] : "unknown";
+}
+
+#pragma pack(push, 1)
+struct TraceFileHeader
+{
+  char magic[8];          // "SRVTRACE"
+  uint32_t version;
+  uint32_t record_size;
+  int32_t pid;
+  char process[28];
+};
+
+struct TraceRecord
+{
+  uint64_t timestamp_ns;  // CLOCK_MONOTONIC
+  int64_t sequence;
+  uint32_t service;       // trace_service_id() of the fully qualified service name
+  uint8_t event;          // TraceEvent
+  uint8_t reserved[3];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(TraceRecord) == 24, "trace record layout changed");
+
+constexpr char kTraceMagic[8] = {'S', 'R', 'V', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t kTraceVersion = 2;
+
+// FNV-1a of the service name, e.g. "/add_two_ints"
+inline uint32_t trace_service_id(const char * name)
+{
+  uint32_t hash = 2166136261u;
+  for (; *name != '\0'; ++name) {
+    hash ^= static_cast<uint8_t>(*name);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+class ServiceTracer
+{
+public:
+  static ServiceTracer & instance()
+  {
+    static ServiceTracer tracer;
+    return tracer;
+  }
+
+  bool enabled() const {return fd_ >= 0;}
+
+  // Id for a fully qualified service name; the name is written once so the analyzer can print it.
+  uint32_t register_service(const char * name)
+  {
+    uint32_t id = trace_service_id(name);
+    if (fd_ < 0) {
+      return id;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto known : services_) {
+      if (known == id) {
+        return id;
+      }
+    }
+    services_.push_back(id);
+    size_t length = std::strlen(name);
+    for (size_t chunk = 0; chunk * 16 < length && chunk < 256; ++chunk) {
+      TraceRecord r{};
+      char text[16] = {};
+      std::strncpy(text, name + chunk * 16, sizeof(text));
+      std::memcpy(reinterpret_cast<char *>(&r), text, sizeof(text));  // timestamp_ns + sequence
+      r.service = id;
+      r.event = static_cast<uint8_t>(TraceEvent::ServiceName);
+      r.reserved[0] = static_cast<uint8_t>(chunk);
+      buffer_.push_back(r);
+    }
+    return id;
+  }
+
+  void record(TraceEvent event, uint32_t service, int64_t sequence)
+  {
+    if (fd_ < 0) {
+      return;
+    }
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    TraceRecord r{};
+    r.timestamp_ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    r.sequence = sequence;
+    r.service = service;
+    r.event = static_cast<uint8_t>(event);
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer_.push_back(r);
+    if (buffer_.size() >= kFlushRecords) {
+      flush_locked();
+    }
+  }
+
+  ~ServiceTracer()
+  {
+    if (fd_ >= 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      flush_locked();
+      ::close(fd_);
+    }
+  }
+
+  ServiceTracer(const ServiceTracer &) = delete;
+  ServiceTracer & operator=(const ServiceTracer &) = delete;
+
+private:
+  static constexpr size_t kFlushRecords = 4096;
+
+  ServiceTracer()
+  {
+    const char * dir = std::getenv("SRVCLI_TRACE_DIR");
+    if (dir == nullptr || dir[0] == '\0') {
+      return;
+    }
+    std::string path = std::string(dir) + "/" + program_invocation_short_name + "-" +
+      std::to_string(::getpid()) + ".srvtrace";
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      std::fprintf(stderr, "service trace: cannot open %s: %s\n", path.c_str(), std::strerror(errno));
+      return;
+    }
+    TraceFileHeader header{};
+    std::memcpy(header.magic, kTraceMagic, sizeof(header.magic));
+    header.version = kTraceVersion;
+    header.record_size = sizeof(TraceRecord);
+    header.pid = static_cast<int32_t>(::getpid());
+    std::strncpy(header.process, program_invocation_short_name, sizeof(header.process) - 1);
+    write_all(&header, sizeof(header));
+    buffer_.reserve(kFlushRecords);
+  }
+
+  void flush_locked()
+  {
+    write_all(buffer_.data(), buffer_.size() * sizeof(TraceRecord));
+    buffer_.clear();
+  }
+
+  void write_all(const void * data, size_t size)
+  {
+    auto p = static_cast<const char *>(data);
+    while (size > 0) {
+      ssize_t n = ::write(fd_, p, size);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return;
+      }
+      p += n;
+      size -= static_cast<size_t>(n);
+    }
+  }
+
+  int fd_ = -1;
+  std::mutex mutex_;
+  std::vector<TraceRecord> buffer_;
+  std::vector<uint32_t> services_;
+};
+
+inline void trace(TraceEvent event, uint32_t service, int64_t sequence)
+{
+  ServiceTracer::instance().record(event, service, sequence);
+}
+
+}  // namespace cpp_srvcli
+
+#endif  // CPP_SRVCLI__SERVICE_TRACE_HPP_
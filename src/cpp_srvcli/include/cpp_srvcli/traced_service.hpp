@@ -0,0 +1,86 @@
+#ifndef CPP_SRVCLI__TRACED_SERVICE_HPP_
+#define CPP_SRVCLI__TRACED_SERVICE_HPP_
+
+// rclcpp::Service that stamps server_received / handler_start / handler_end / response_sent
+// (see service_trace.hpp) around an ordinary synchronous callback.
+//
+//   auto service = cpp_srvcli::create_traced_service<AddTwoInts>(node, "add_two_ints", &add);
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "rclcpp/rclcpp.hpp"
+#include "cpp_srvcli/service_trace.hpp"
+
+namespace cpp_srvcli
+{
+
+template<typename ServiceT>
+class TracedService : public rclcpp::Service<ServiceT>
+{
+public:
+  using Request = typename ServiceT::Request;
+  using Response = typename ServiceT::Response;
+  using Callback = std::function<void(std::shared_ptr<Request>, std::shared_ptr<Response>)>;
+
+  TracedService(
+    std::shared_ptr<rcl_node_t> node_handle, const std::string & service_name,
+    rcl_service_options_t & options, Callback callback)
+  : rclcpp::Service<ServiceT>(node_handle, service_name, wrap(callback), options),
+    callback_(std::move(callback)),
+    service_id_(ServiceTracer::instance().register_service(this->get_service_name()))
+  {
+  }
+
+  void handle_request(
+    std::shared_ptr<rmw_request_id_t> request_header, std::shared_ptr<void> request) override
+  {
+    const int64_t seq = request_header->sequence_number;
+    trace(TraceEvent::ServerReceived, service_id_, seq);
+    auto typed_request = std::static_pointer_cast<Request>(request);
+    auto response = std::make_shared<Response>();
+    trace(TraceEvent::HandlerStart, service_id_, seq);
+    callback_(typed_request, response);
+    trace(TraceEvent::HandlerEnd, service_id_, seq);
+    rcl_ret_t ret = rcl_send_response(
+      this->get_service_handle().get(), request_header.get(), response.get());
+    if (ret != RCL_RET_OK) {
+      rclcpp::exceptions::throw_from_rcl_error(ret, "failed to send response");
+    }
+    trace(TraceEvent::ResponseSent, service_id_, seq);
+  }
+
+private:
+  static rclcpp::AnyServiceCallback<ServiceT> wrap(Callback callback)
+  {
+    rclcpp::AnyServiceCallback<ServiceT> any_callback;
+    any_callback.set(
+      [callback](const std::shared_ptr<Request> request, std::shared_ptr<Response> response) {
+        callback(request, response);
+      });
+    return any_callback;
+  }
+
+  Callback callback_;
+  uint32_t service_id_;
+};
+
+// Drop-in for node->create_service<ServiceT>(name, callback) with two-argument callbacks.
+template<typename ServiceT, typename CallbackT>
+std::shared_ptr<TracedService<ServiceT>> create_traced_service(
+  rclcpp::Node::SharedPtr node, const std::string & service_name, CallbackT && callback)
+{
+  rcl_service_options_t options = rcl_service_get_default_options();
+  options.qos = rmw_qos_profile_services_default;
+  auto service = std::make_shared<TracedService<ServiceT>>(
+    node->get_node_base_interface()->get_shared_rcl_node_handle(), service_name, options,
+    typename TracedService<ServiceT>::Callback(std::forward<CallbackT>(callback)));
+  node->get_node_services_interface()->add_service(service, nullptr);
+  return service;
+}
+
+}  // namespace cpp_srvcli
+
+#endif  // CPP_SRVCLI__TRACED_SERVICE_HPP_
@@ -0,0 +1,85 @@
+#ifndef CPP_SRVCLI__WORKER_POOL_HPP_
+#define CPP_SRVCLI__WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cpp_srvcli
+{
+
+// Fixed number of worker threads draining one FIFO of tasks.
+// Admission control (queue bounds, per-service limits) is done by the caller.
+class WorkerPool
+{
+public:
+  explicit WorkerPool(size_t threads)
+  {
+    if (threads == 0) {
+      threads = 1;
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back([this]() {run();});
+    }
+  }
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto & worker : workers_) {
+      worker.join();
+    }
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  void submit(std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+  size_t size() const {return workers_.size();}
+
+private:
+  void run()
+  {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() {return stopping_ || !tasks_.empty();});
+        if (tasks_.empty()) {
+          return;  // stopping and drained
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace cpp_srvcli
+
+#endif  // CPP_SRVCLI__WORKER_POOL_HPP_
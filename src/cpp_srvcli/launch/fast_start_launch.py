@@ -0,0 +1,50 @@
+import os
+
+from ament_index_python.packages import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, OpaqueFunction
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+
+# AddThreeInts server and client pre-created in one component container.
+# ros2 launch cpp_srvcli fast_start_launch.py fast_discovery:=true requests:=10
+def launch_setup(context):
+    env = dict(os.environ)
+    env['RMW_IMPLEMENTATION'] = 'rmw_fastrtps_cpp'
+    if LaunchConfiguration('fast_discovery').perform(context) == 'true':
+        env['FASTRTPS_DEFAULT_PROFILES_FILE'] = os.path.join(
+            get_package_share_directory('cpp_srvcli'), 'config', 'fastdds_localhost_discovery.xml')
+    requests = int(LaunchConfiguration('requests').perform(context))
+    return [
+        ComposableNodeContainer(
+            name='srvcli_container',
+            namespace='',
+            package='rclcpp_components',
+            executable='component_container',
+            composable_node_descriptions=[
+                ComposableNode(
+                    package='cpp_srvcli',
+                    plugin='cpp_srvcli::AddThreeIntsServer',
+                    name='add_three_ints_server'),
+                ComposableNode(
+                    package='cpp_srvcli',
+                    plugin='cpp_srvcli::AddThreeIntsClient',
+                    name='add_three_ints_client',
+                    parameters=[{'requests': requests}]),
+            ],
+            output='screen',
+            env=env,
+        ),
+    ]
+
+
+def generate_launch_description():
+    return LaunchDescription([
+        DeclareLaunchArgument(
+            'fast_discovery', default_value='false',
+            description='use config/fastdds_localhost_discovery.xml'),
+        DeclareLaunchArgument('requests', default_value='1'),
+        OpaqueFunction(function=launch_setup),
+    ])
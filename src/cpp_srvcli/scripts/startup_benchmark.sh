@@ -0,0 +1,109 @@
+#!/usr/bin/env bash
+# Time to first response / first message, measured from process start by the
+# tutorial_utils::StartupProfiler line each executable prints, for:
+#   srv_separate       service_new_intf + client_new_intf as two processes
+#   srv_separate_fast  same, with config/fastdds_localhost_discovery.xml
+#   srv_composed       both as components in one container (launch/fast_start_launch.py)
+#   srv_composed_fast  same, with the localhost discovery profile
+#   pubsub_separate    talker + listener as two processes (time to the listener's first message)
+#   pubsub_fast        same, with the localhost discovery profile
+#
+# ros2 run cpp_srvcli startup_benchmark.sh [runs]
+set -u
+
+RUNS=${1:-10}
+SRVCLI_PREFIX=$(ros2 pkg prefix cpp_srvcli)
+PUBSUB_PREFIX=$(ros2 pkg prefix cpp_pubsub)
+SRVCLI=$SRVCLI_PREFIX/lib/cpp_srvcli
+PUBSUB=$PUBSUB_PREFIX/lib/cpp_pubsub
+FAST_PROFILE=$SRVCLI_PREFIX/share/cpp_srvcli/config/fastdds_localhost_discovery.xml
+
+export TUTORIAL_STARTUP_PROFILE=1
+export RMW_IMPLEMENTATION=rmw_fastrtps_cpp
+unset FASTRTPS_DEFAULT_PROFILES_FILE
+
+# run_until <pattern> <timeout_s> <cmd...>: run cmd in its own process group, print the first
+# output line matching pattern, then stop the whole group
+run_until() {
+  local pattern=$1 limit=$2
+  shift 2
+  local log
+  log=$(mktemp)
+  setsid "$@" > "$log" 2>&1 &
+  local pid=$!
+  local deadline=$((SECONDS + limit))
+  while ! grep -q "$pattern" "$log" && [ $SECONDS -lt $deadline ]; do
+    sleep 0.05
+  done
+  grep -m1 "$pattern" "$log"
+  kill -INT -- -$pid 2>/dev/null
+  wait $pid 2>/dev/null
+  rm -f "$log"
+}
+
+# start_background <cmd...>: start a peer process in its own group, prints its pid
+start_background() {
+  setsid "$@" > /dev/null 2>&1 &
+  echo $!
+}
+
+stop_background() {
+  kill -INT -- -"$1" 2>/dev/null
+  wait "$1" 2>/dev/null
+}
+
+# phase_ms <phase>: read "<phase>=<ms>ms" from a startup line on stdin
+phase_ms() {
+  grep -o " $1=[0-9.]*" | head -1 | cut -d= -f2
+}
+
+srv_separate() {
+  local server
+  server=$(start_background "$SRVCLI/service_new_intf")
+  run_until "startup: client_new_intf" 30 "$SRVCLI/client_new_intf" 1 2 3 | phase_ms first_response
+  stop_background "$server"
+}
+
+srv_composed() {
+  run_until "startup: component_container" 30 \
+    ros2 launch cpp_srvcli fast_start_launch.py fast_discovery:="$1" | phase_ms first_response
+}
+
+pubsub_separate() {
+  local talker
+  talker=$(start_background "$PUBSUB/talker")
+  run_until "startup: listener" 30 "$PUBSUB/listener" | phase_ms first_message
+  stop_background "$talker"
+}
+
+# summarize <name> <values...>: median / min / max in ms
+summarize() {
+  local name=$1
+  shift
+  printf '%s\n' "$@" | grep -v '^$' | sort -n | awk -v name="$name" '
+    { v[NR] = $1 }
+    END {
+      if (NR == 0) { printf "%-18s no samples\n", name; exit }
+      m = (NR % 2) ? v[(NR + 1) / 2] : (v[NR / 2] + v[NR / 2 + 1]) / 2
+      printf "%-18s n=%-3d median=%8.1f ms  min=%8.1f ms  max=%8.1f ms\n", name, NR, m, v[1], v[NR]
+    }'
+}
+
+measure() {
+  local name=$1
+  shift
+  local samples=()
+  for ((i = 0; i < RUNS; ++i)); do
+    samples+=("$("$@")")
+  done
+  summarize "$name" "${samples[@]}"
+}
+
+measure srv_separate srv_separate
+measure srv_composed srv_composed false
+measure pubsub_separate pubsub_separate
+export FASTRTPS_DEFAULT_PROFILES_FILE=$FAST_PROFILE
+measure srv_separate_fast srv_separate
+measure pubsub_fast pubsub_separate
+unset FASTRTPS_DEFAULT_PROFILES_FILE
+measure srv_composed_fast srv_composed true
@@ -0,0 +1,110 @@
+// AddThreeInts server and client as components, so both can be loaded into one container
+// (launch/fast_start_launch.py) with their entities created before the container spins.
+//
+// The client waits for the service on a helper thread blocked on the graph event, so it does
+// not stall the container's executor, and sends its first request the moment the server is
+// discovered. The startup profile line ends at the client's first response.
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
+#include "tutorial_interfaces/srv/add_three_ints.hpp"
+#include "tutorial_utils/startup.hpp"
+
+namespace cpp_srvcli
+{
+
+using AddThreeInts = tutorial_interfaces::srv::AddThreeInts;
+
+class AddThreeIntsServer : public rclcpp::Node
+{
+public:
+  explicit AddThreeIntsServer(const rclcpp::NodeOptions & options)
+  : Node("add_three_ints_server", options)
+  {
+    service_ = this->create_service<AddThreeInts>(
+      "add_three_ints",
+      [this](const std::shared_ptr<AddThreeInts::Request> request,
+      std::shared_ptr<AddThreeInts::Response> response) {
+        tutorial_utils::startup_mark("first_request");
+        response->sum = request->a + request->b + request->c;
+        RCLCPP_DEBUG(
+          this->get_logger(), "%ld + %ld + %ld = %ld", request->a, request->b, request->c,
+          response->sum);
+      });
+    tutorial_utils::startup_mark("server");
+  }
+
+private:
+  rclcpp::Service<AddThreeInts>::SharedPtr service_;
+};
+
+class AddThreeIntsClient : public rclcpp::Node
+{
+public:
+  explicit AddThreeIntsClient(const rclcpp::NodeOptions & options)
+  : Node("add_three_ints_client", options)
+  {
+    requests_ = this->declare_parameter<int>("requests", 1);
+    a_ = this->declare_parameter<int>("a", 1);
+    b_ = this->declare_parameter<int>("b", 2);
+    c_ = this->declare_parameter<int>("c", 3);
+    client_ = this->create_client<AddThreeInts>("add_three_ints");
+    tutorial_utils::startup_mark("client");
+
+    waiter_ = std::thread(
+      [this]() {
+        bool ready = tutorial_utils::wait_for_graph(
+          *this, [this]() {return stop_.load() || client_->service_is_ready();},
+          std::chrono::seconds(30));
+        if (!ready || stop_.load()) {
+          return;
+        }
+        tutorial_utils::startup_mark("service");
+        send_request();
+      });
+  }
+
+  ~AddThreeIntsClient() override
+  {
+    stop_ = true;
+    if (waiter_.joinable()) {
+      waiter_.join();
+    }
+  }
+
+private:
+  void send_request()
+  {
+    auto request = std::make_shared<AddThreeInts::Request>();
+    request->a = a_;
+    request->b = b_;
+    request->c = c_;
+    client_->async_send_request(
+      request, [this](rclcpp::Client<AddThreeInts>::SharedFuture future) {
+        tutorial_utils::StartupProfiler::instance().finish("first_response", this->get_logger());
+        RCLCPP_INFO(this->get_logger(), "Sum: %ld", future.get()->sum);
+        if (++sent_ < requests_) {
+          send_request();
+        }
+      });
+  }
+
+  rclcpp::Client<AddThreeInts>::SharedPtr client_;
+  std::thread waiter_;
+  std::atomic<bool> stop_{false};
+  int requests_;
+  int sent_ = 0;
+  int64_t a_;
+  int64_t b_;
+  int64_t c_;
+};
+
+}  // namespace cpp_srvcli
+
+RCLCPP_COMPONENTS_REGISTER_NODE(cpp_srvcli::AddThreeIntsServer)
+RCLCPP_COMPONENTS_REGISTER_NODE(cpp_srvcli::AddThreeIntsClient)
@@ -117,6 +117,8 @@
 #include <memory>
 #include "rclcpp/rclcpp.hpp"
 #include "example_interfaces/srv/add_two_ints.hpp"
+#include "cpp_srvcli/service_trace.hpp"
+#include "tutorial_utils/startup.hpp"
 
 using namespace std::chrono_literals;
 
@@ -126,44 +128,61 @@ public:
     AddTwoIntsClient() : Node("add_two_ints_client")
     {
         client_ = this->create_client<example_interfaces::srv::AddTwoInts>("add_two_ints");
+        service_id_ = cpp_srvcli::ServiceTracer::instance().register_service(client_->get_service_name());
         timer_ = this->create_wall_timer(
             500ms, std::bind(&AddTwoIntsClient::send_request, this));
+        tutorial_utils::startup_mark("node");
     }
 
 private:
     void send_request()
     {
+        // 追踪（SRVCLI_TRACE_DIR 设置时）：序号与服务端 rmw_request_id_t.sequence_number 一致，
+        // 本客户端的第 n 个请求序号为 n
+        const int64_t seq = next_sequence_;
         auto request = std::make_shared<example_interfaces::srv::AddTwoInts::Request>();
         request->a = 22222;
         request->b = 33333;
         RCLCPP_INFO(this->get_logger(), "Sending request with a: %ld, b: %ld", request->a, request->b);
 
-        while (!client_->wait_for_service(1s)) {
+        // 阻塞在图变化事件上等待服务出现，而不是每秒轮询一次
+        if (!tutorial_utils::wait_for_service(*this, *client_, 30s)) {
             if (!rclcpp::ok()) {
                 RCLCPP_ERROR(this->get_logger(), "Interrupted while waiting for the service. Exiting.");
-                return;
             }
-            RCLCPP_INFO(this->get_logger(), "Service not available, waiting again...");
+            return;
         }
+        tutorial_utils::startup_mark("service");
+        // 服务可用之后才记录：等待失败时这个序号会被下一次请求重用，提前记录会重复
+        cpp_srvcli::trace(cpp_srvcli::TraceEvent::RequestCreated, service_id_, seq);
 
         // 发送异步请求，使用回调函数接收结果
         auto future_result = client_->async_send_request(request,
-            std::bind(&AddTwoIntsClient::response_callback, this, std::placeholders::_1));
+            [this, seq](rclcpp::Client<example_interfaces::srv::AddTwoInts>::SharedFuture future) {
+                cpp_srvcli::trace(cpp_srvcli::TraceEvent::ClientReceived, service_id_, seq);
+                response_callback(future);
+            });
+        ++next_sequence_;
+        cpp_srvcli::trace(cpp_srvcli::TraceEvent::RequestSent, service_id_, seq);
     }
 
     void response_callback(rclcpp::Client<example_interfaces::srv::AddTwoInts>::SharedFuture future)
     {
         auto result = future.get();
+        tutorial_utils::StartupProfiler::instance().finish("first_response", this->get_logger());
         RCLCPP_INFO(this->get_logger(), "Sum: %ld", result->sum);
     }
 
     rclcpp::Client<example_interfaces::srv::AddTwoInts>::SharedPtr client_;
     rclcpp::TimerBase::SharedPtr timer_;
+    uint32_t service_id_;
+    int64_t next_sequence_ = 1;  // rcl 客户端的请求序号从 1 开始
 };
 
 int main(int argc, char **argv)
 {
     rclcpp::init(argc, argv);
+    tutorial_utils::startup_mark("init");
     rclcpp::spin(std::make_shared<AddTwoIntsClient>());
     rclcpp::shutdown();
     return 0;
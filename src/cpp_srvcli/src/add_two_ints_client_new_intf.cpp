@@ -1,5 +1,7 @@
 #include "rclcpp/rclcpp.hpp"
 #include "tutorial_interfaces/srv/add_three_ints.hpp"        // CHANGE
+#include "cpp_srvcli/service_trace.hpp"
+#include "tutorial_utils/startup.hpp"
 
 #include <chrono>
 #include <cstdlib>
@@ -10,6 +12,7 @@ using namespace std::chrono_literals;
 int main(int argc, char **argv)
 {
   rclcpp::init(argc, argv);
+  tutorial_utils::startup_mark("init");
 
   if (argc != 4) { // CHANGE
       RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "usage: add_three_ints_client X Y Z");      // CHANGE
@@ -19,25 +22,34 @@ int main(int argc, char **argv)
   std::shared_ptr<rclcpp::Node> node = rclcpp::Node::make_shared("add_three_ints_client"); // CHANGE
   rclcpp::Client<tutorial_interfaces::srv::AddThreeInts>::SharedPtr client =                        // CHANGE
     node->create_client<tutorial_interfaces::srv::AddThreeInts>("add_three_ints");                  // CHANGE
+  tutorial_utils::startup_mark("node");
+  // single request: sequence number 1 on both sides of the trace
+  const uint32_t service_id = cpp_srvcli::ServiceTracer::instance().register_service(client->get_service_name());
 
   auto request = std::make_shared<tutorial_interfaces::srv::AddThreeInts::Request>();               // CHANGE
   request->a = atoll(argv[1]);
   request->b = atoll(argv[2]);
   request->c = atoll(argv[3]);               // CHANGE
 
-  while (!client->wait_for_service(1s)) {
+  // wake up on graph changes instead of polling wait_for_service(1s)
+  if (!tutorial_utils::wait_for_service(*node, *client, 30s)) {
     if (!rclcpp::ok()) {
       RCLCPP_ERROR(rclcpp::get_logger("rclcpp"), "Interrupted while waiting for the service. Exiting.");
       return 0;
     }
-    RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "service not available, waiting again...");
+    return 1;
   }
+  tutorial_utils::startup_mark("service");
 
+  cpp_srvcli::trace(cpp_srvcli::TraceEvent::RequestCreated, service_id, 1);
   auto result = client->async_send_request(request);
+  cpp_srvcli::trace(cpp_srvcli::TraceEvent::RequestSent, service_id, 1);
   // Wait for the result.
   if (rclcpp::spin_until_future_complete(node, result) ==
     rclcpp::executor::FutureReturnCode::SUCCESS)
   {
+    cpp_srvcli::trace(cpp_srvcli::TraceEvent::ClientReceived, service_id, 1);
+    tutorial_utils::StartupProfiler::instance().finish("first_response", node->get_logger());
     RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "Sum: %ld", result.get()->sum);
   } else {
     RCLCPP_ERROR(rclcpp::get_logger("rclcpp"), "Failed to call service add_three_ints");    // CHANGE
@@ -1,22 +1,18 @@
 #include "rclcpp/rclcpp.hpp"
 #include "example_interfaces/srv/add_two_ints.hpp"
+#include "cpp_srvcli/add_two_ints.hpp"  // add(), shared with the perf test
+#include "cpp_srvcli/traced_service.hpp"  // per-hop timestamps when SRVCLI_TRACE_DIR is set
+#include "tutorial_utils/startup.hpp"
 
 #include <chrono> // std::chrono::seconds
 #include <functional> // std::bind
 #include <memory>
 
-void add(const std::shared_ptr<example_interfaces::srv::AddTwoInts::Request> request,
-               std::shared_ptr<example_interfaces::srv::AddTwoInts::Response> response)
-{
-  response->sum = request->a + request->b;
-  RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "Incoming request\na: %ld" " b: %ld",
-                request->a, request->b);
-  RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "sending back response: [%ld]", (long int)response->sum);
-}
 void multiply(const std::shared_ptr<example_interfaces::srv::AddTwoInts::Request> request,
                std::shared_ptr<example_interfaces::srv::AddTwoInts::Response> response)
 {
   response->sum = request->a * request->b;
+  tutorial_utils::StartupProfiler::instance().finish("first_request", rclcpp::get_logger("rclcpp"));
   RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "Incoming request: a: %ld" " b: %ld",
                 request->a, request->b);
   RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "sending back response: [%ld]", (long int)response->sum);
@@ -25,15 +21,18 @@ void multiply(const std::shared_ptr<example_interfaces::srv::AddTwoInts::Request
 int main(int argc, char **argv)
 {
   rclcpp::init(argc, argv);
+  tutorial_utils::startup_mark("init");
 
   std::shared_ptr<rclcpp::Node> node = rclcpp::Node::make_shared("add_two_ints_server");
+  tutorial_utils::startup_mark("node");
 
   rclcpp::Service<example_interfaces::srv::AddTwoInts>::SharedPtr add_service =
-    node->create_service<example_interfaces::srv::AddTwoInts>("add_two_ints", &add);
+    cpp_srvcli::create_traced_service<example_interfaces::srv::AddTwoInts>(node, "add_two_ints", &cpp_srvcli::add);
 
   rclcpp::Service<example_interfaces::srv::AddTwoInts>::SharedPtr multiply_service =
-    node->create_service<example_interfaces::srv::AddTwoInts>("multiply_two_ints", &multiply);
+    cpp_srvcli::create_traced_service<example_interfaces::srv::AddTwoInts>(node, "multiply_two_ints", &multiply);
 
+  tutorial_utils::startup_mark("services");
   RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "Ready to add two ints.");
 
   rclcpp::spin(node);
@@ -1,5 +1,7 @@
 #include "rclcpp/rclcpp.hpp"
 #include "tutorial_interfaces/srv/add_three_ints.hpp"     // CHANGE
+#include "cpp_srvcli/traced_service.hpp"
+#include "tutorial_utils/startup.hpp"
 
 #include <memory>
 
@@ -7,6 +9,7 @@ void add(const std::shared_ptr<tutorial_interfaces::srv::AddThreeInts::Request>
           std::shared_ptr<tutorial_interfaces::srv::AddThreeInts::Response>       response)  // CHANGE
 {
   response->sum = request->a + request->b + request->c;                                       // CHANGE
+  tutorial_utils::StartupProfiler::instance().finish("first_request", rclcpp::get_logger("rclcpp"));
   RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "Incoming request\na: %ld" " b: %ld" " c: %ld",   // CHANGE
                 request->a, request->b, request->c);                                          // CHANGE
   RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "sending back response: [%ld]", (long int)response->sum);
@@ -15,12 +18,15 @@ void add(const std::shared_ptr<tutorial_interfaces::srv::AddThreeInts::Request>
 int main(int argc, char **argv)
 {
   rclcpp::init(argc, argv);
+  tutorial_utils::startup_mark("init");
 
   std::shared_ptr<rclcpp::Node> node = rclcpp::Node::make_shared("add_three_ints_server");  // CHANGE
+  tutorial_utils::startup_mark("node");
 
   rclcpp::Service<tutorial_interfaces::srv::AddThreeInts>::SharedPtr service =                 // CHANGE
-    node->create_service<tutorial_interfaces::srv::AddThreeInts>("add_three_ints",  &add);     // CHANGE
+    cpp_srvcli::create_traced_service<tutorial_interfaces::srv::AddThreeInts>(node, "add_three_ints", &add);  // CHANGE
 
+  tutorial_utils::startup_mark("service");
   RCLCPP_INFO(rclcpp::get_logger("rclcpp"), "Ready to add three ints.");      // CHANGE
 
   rclcpp::spin(node);
@@ -0,0 +1,134 @@
+// add_two_ints, multiply_two_ints and add_three_ints on one node, handled on a shared worker
+// pool with per-service concurrency limits (cpp_srvcli::ServiceMultiplexer).
+//
+// Per-service queue and handler times are published on "diagnostics" every metrics_period_ms,
+// with the count of requests rejected because the backlog was full (those are answered with a
+// default response, which AddTwoInts cannot mark as rejected).
+// <service>.delay_ms adds an artificial handler delay to show that a slow service only holds its
+// own slots:
+//
+// ros2 run cpp_srvcli multiplexed_server --ros-args -p workers:=8 -p multiply_two_ints.delay_ms:=50 -p multiply_two_ints.max_concurrency:=2
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "rclcpp/rclcpp.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "example_interfaces/srv/add_two_ints.hpp"
+#include "tutorial_interfaces/srv/add_three_ints.hpp"
+#include "cpp_srvcli/service_multiplexer.hpp"
+#include "tutorial_utils/startup.hpp"
+
+using AddTwoInts = example_interfaces::srv::AddTwoInts;
+using AddThreeInts = tutorial_interfaces::srv::AddThreeInts;
+
+class MultiplexedServer : public rclcpp::Node
+{
+public:
+  MultiplexedServer()
+  : Node("multiplexed_server")
+  {
+    auto workers = this->declare_parameter<int>("workers", 4);
+    auto max_queue = this->declare_parameter<int>("max_queue", 1024);
+    auto metrics_period_ms = this->declare_parameter<int>("metrics_period_ms", 1000);
+    mux_ = std::make_unique<cpp_srvcli::ServiceMultiplexer>(
+      *this, static_cast<size_t>(std::max(workers, 1)), static_cast<size_t>(std::max(max_queue, 0)));
+
+    add<AddTwoInts>(
+      "add_two_ints", [](const AddTwoInts::Request & req, AddTwoInts::Response & res) {
+        res.sum = req.a + req.b;
+      });
+    add<AddTwoInts>(
+      "multiply_two_ints", [](const AddTwoInts::Request & req, AddTwoInts::Response & res) {
+        res.sum = req.a * req.b;
+      });
+    add<AddThreeInts>(
+      "add_three_ints", [](const AddThreeInts::Request & req, AddThreeInts::Response & res) {
+        res.sum = req.a + req.b + req.c;
+      });
+
+    diagnostics_pub_ = this->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("diagnostics", 10);
+    metrics_timer_ = this->create_wall_timer(
+      std::chrono::milliseconds(std::max(metrics_period_ms, 1)),
+      std::bind(&MultiplexedServer::publish_metrics, this));
+
+    RCLCPP_INFO(
+      this->get_logger(), "Serving add_two_ints, multiply_two_ints, add_three_ints on %zu workers",
+      mux_->threads());
+  }
+
+private:
+  // <name>.max_concurrency (default: all workers) and <name>.delay_ms (default 0) per service
+  template<typename ServiceT, typename HandlerT>
+  void add(const std::string & name, HandlerT handler)
+  {
+    auto max_concurrency = this->declare_parameter<int>(
+      name + ".max_concurrency", static_cast<int>(mux_->threads()));
+    auto delay = std::chrono::milliseconds(this->declare_parameter<int>(name + ".delay_ms", 0));
+    mux_->add_service<ServiceT>(
+      name, static_cast<size_t>(std::max(max_concurrency, 1)),
+      [handler, delay](const typename ServiceT::Request & req, typename ServiceT::Response & res) {
+        if (delay.count() > 0) {
+          std::this_thread::sleep_for(delay);
+        }
+        handler(req, res);
+        tutorial_utils::StartupProfiler::instance().finish(
+          "first_request", rclcpp::get_logger("multiplexed_server"));
+      });
+  }
+
+  void publish_metrics()
+  {
+    diagnostic_msgs::msg::DiagnosticArray array;
+    array.header.stamp = this->now();
+    for (const auto & s : mux_->stats()) {
+      diagnostic_msgs::msg::DiagnosticStatus status;
+      status.name = std::string(this->get_name()) + ": " + s.name;
+      status.level = s.rejected > 0 ? diagnostic_msgs::msg::DiagnosticStatus::WARN :
+        diagnostic_msgs::msg::DiagnosticStatus::OK;
+      status.message = s.rejected > 0 ? "requests rejected, backlog full" : "ok";
+      double completed = s.completed > 0 ? static_cast<double>(s.completed) : 1.0;
+      add_value(status, "max_concurrency", std::to_string(s.max_concurrency));
+      add_value(status, "received", std::to_string(s.received));
+      add_value(status, "completed", std::to_string(s.completed));
+      add_value(status, "rejected", std::to_string(s.rejected));
+      add_value(status, "running", std::to_string(s.running));
+      add_value(status, "queued", std::to_string(s.queued));
+      add_value(status, "max_queued", std::to_string(s.max_queued));
+      add_value(status, "queue_wait_ms_mean", std::to_string(s.queue_wait_ms_total / completed));
+      add_value(status, "queue_wait_ms_max", std::to_string(s.queue_wait_ms_max));
+      add_value(status, "handler_ms_mean", std::to_string(s.handler_ms_total / completed));
+      add_value(status, "handler_ms_max", std::to_string(s.handler_ms_max));
+      array.status.push_back(std::move(status));
+    }
+    diagnostics_pub_->publish(array);
+  }
+
+  static void add_value(
+    diagnostic_msgs::msg::DiagnosticStatus & status, const char * key, const std::string & value)
+  {
+    diagnostic_msgs::msg::KeyValue kv;
+    kv.key = key;
+    kv.value = value;
+    status.values.push_back(std::move(kv));
+  }
+
+  std::unique_ptr<cpp_srvcli::ServiceMultiplexer> mux_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_pub_;
+  rclcpp::TimerBase::SharedPtr metrics_timer_;
+};
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  tutorial_utils::startup_mark("init");
+  auto node = std::make_shared<MultiplexedServer>();
+  tutorial_utils::startup_mark("node");
+  // handle_request only queues the work, so one executor thread is enough
+  rclcpp::spin(node);
+  rclcpp::shutdown();
+  return 0;
+}
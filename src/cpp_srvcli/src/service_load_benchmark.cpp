@@ -0,0 +1,281 @@
+// Aggregate requests/second against one service with 1..64 closed-loop client threads.
+// Each thread owns a client and keeps exactly one request outstanding.
+//
+// ros2 run cpp_srvcli multiplexed_server --ros-args -p workers:=8
+// ros2 run cpp_srvcli service_load_benchmark --ros-args -p service:=add_two_ints -p threads:="1,2,4,8,16,32,64" -p duration_s:=3.0
+//
+// Run it against cpp_service (serial spin, two log lines per request) for the baseline.
+//
+// Requests multiplexed_server rejects (backlog full) still get a response, and AddTwoInts has no
+// field to mark it, so the client cannot tell them apart. The rejected count is the server's own:
+// the cumulative "rejected" value of "<server>: <service>" on "diagnostics", read once a metrics
+// period has passed after each step. Those requests are subtracted from completed (their fast
+// responses stay in the latency percentiles); against a server that publishes no such status
+// (cpp_service never rejects) rejected is reported as n/a.
+//
+// A request that times out is still waited for (until the step ends) before the thread sends the
+// next one: Foxy clients cannot drop a pending request, so abandoning it would leave its entry in
+// the client for good.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "example_interfaces/srv/add_two_ints.hpp"
+#include "tutorial_interfaces/srv/add_three_ints.hpp"
+#include "tutorial_utils/startup.hpp"
+
+using namespace std::chrono_literals;
+using AddTwoInts = example_interfaces::srv::AddTwoInts;
+using AddThreeInts = tutorial_interfaces::srv::AddThreeInts;
+
+struct StepResult
+{
+  size_t threads = 0;
+  uint64_t completed = 0;
+  uint64_t timeouts = 0;
+  uint64_t rejected = 0;
+  bool rejected_known = false;
+  double seconds = 0.0;
+  std::vector<double> latencies_us;
+};
+
+// The server's cumulative reject count for one service, from its "diagnostics" status
+class ServerRejects
+{
+public:
+  ServerRejects(rclcpp::Node::SharedPtr node, const std::string & service)
+  : suffix_(": " + service)
+  {
+    sub_ = node->create_subscription<diagnostic_msgs::msg::DiagnosticArray>(
+      "diagnostics", 10,
+      [this](const diagnostic_msgs::msg::DiagnosticArray::SharedPtr msg) {on_diagnostics(*msg);});
+  }
+
+  // The count from the first status received after this call; false if none within timeout
+  bool read(std::chrono::milliseconds timeout, uint64_t & rejected)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t seen = updates_;
+    if (!cv_.wait_for(lock, timeout, [this, seen]() {return updates_ > seen;})) {
+      return false;
+    }
+    rejected = rejected_;
+    return true;
+  }
+
+private:
+  void on_diagnostics(const diagnostic_msgs::msg::DiagnosticArray & msg)
+  {
+    for (const auto & status : msg.status) {
+      if (status.name.size() < suffix_.size() ||
+        status.name.compare(status.name.size() - suffix_.size(), suffix_.size(), suffix_) != 0)
+      {
+        continue;
+      }
+      for (const auto & kv : status.values) {
+        if (kv.key == "rejected") {
+          std::lock_guard<std::mutex> lock(mutex_);
+          rejected_ = std::strtoull(kv.value.c_str(), nullptr, 10);
+          ++updates_;
+          cv_.notify_all();
+        }
+      }
+    }
+  }
+
+  std::string suffix_;
+  rclcpp::Subscription<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr sub_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  uint64_t rejected_ = 0;
+  uint64_t updates_ = 0;
+};
+
+template<typename ServiceT>
+class LoadRunner
+{
+public:
+  LoadRunner(rclcpp::Node::SharedPtr node, const std::string & service, size_t max_threads)
+  : node_(node)
+  {
+    // all clients exist before the executor starts spinning
+    for (size_t i = 0; i < max_threads; ++i) {
+      clients_.push_back(node_->create_client<ServiceT>(service));
+    }
+  }
+
+  bool wait_for_service(std::chrono::seconds timeout)
+  {
+    return tutorial_utils::wait_for_service(*node_, *clients_.front(), timeout);
+  }
+
+  StepResult run(size_t threads, std::chrono::duration<double> duration, std::chrono::milliseconds timeout)
+  {
+    StepResult result;
+    result.threads = threads;
+    std::vector<std::vector<double>> latencies(threads);
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> timeouts{0};
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration);
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back(
+        [&, t]() {
+          auto client = clients_[t];
+          auto request = std::make_shared<typename ServiceT::Request>();
+          request->a = static_cast<int64_t>(t);
+          request->b = 2;
+          set_c(*request);
+          latencies[t].reserve(65536);
+          while (rclcpp::ok() && std::chrono::steady_clock::now() < deadline) {
+            auto sent = std::chrono::steady_clock::now();
+            auto future = client->async_send_request(request);
+            if (future.wait_for(timeout) != std::future_status::ready) {
+              ++timeouts;
+              // drain the late response so the client's pending entry goes away
+              while (rclcpp::ok() && future.wait_for(timeout) != std::future_status::ready &&
+                std::chrono::steady_clock::now() < deadline)
+              {
+              }
+              continue;
+            }
+            latencies[t].push_back(
+              std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent).count());
+            ++completed;
+          }
+        });
+    }
+    for (auto & worker : workers) {
+      worker.join();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.completed = completed.load();
+    result.timeouts = timeouts.load();
+    for (auto & l : latencies) {
+      result.latencies_us.insert(result.latencies_us.end(), l.begin(), l.end());
+    }
+    return result;
+  }
+
+private:
+  static void set_c(AddTwoInts::Request &) {}
+  static void set_c(AddThreeInts::Request & request) {request.c = 3;}
+
+  rclcpp::Node::SharedPtr node_;
+  std::vector<typename rclcpp::Client<ServiceT>::SharedPtr> clients_;
+};
+
+static std::vector<size_t> parse_threads(const std::string & list)
+{
+  std::vector<size_t> out;
+  std::stringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    int n = std::atoi(item.c_str());
+    if (n > 0) {
+      out.push_back(static_cast<size_t>(n));
+    }
+  }
+  return out;
+}
+
+static void report(const rclcpp::Logger & logger, StepResult & r)
+{
+  std::string rejected = r.rejected_known ? std::to_string(r.rejected) : "n/a";
+  auto & v = r.latencies_us;
+  std::sort(v.begin(), v.end());
+  auto at = [&v](double q) {
+      return v.empty() ? 0.0 : v[std::min(static_cast<size_t>(q * static_cast<double>(v.size() - 1) + 0.5), v.size() - 1)];
+    };
+  RCLCPP_INFO(
+    logger,
+    "threads=%-3zu req/s=%9.1f completed=%-8lu timeouts=%-4lu rejected=%-6s latency(us) p50=%8.1f p99=%8.1f max=%8.1f",
+    r.threads, static_cast<double>(r.completed) / r.seconds, static_cast<unsigned long>(r.completed),
+    static_cast<unsigned long>(r.timeouts), rejected.c_str(), at(0.5), at(0.99), v.empty() ? 0.0 : v.back());
+}
+
+template<typename ServiceT>
+static int run_all(
+  rclcpp::Node::SharedPtr node, const std::string & service, const std::vector<size_t> & steps,
+  double duration_s, int timeout_ms, int metrics_timeout_ms)
+{
+  size_t max_threads = *std::max_element(steps.begin(), steps.end());
+  LoadRunner<ServiceT> runner(node, service, max_threads);
+  ServerRejects server_rejects(node, service);
+  auto metrics_timeout = std::chrono::milliseconds(metrics_timeout_ms);
+
+  rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(), 4);
+  executor.add_node(node);
+  std::thread spinner([&executor]() {executor.spin();});
+
+  int ret = 0;
+  if (!runner.wait_for_service(30s)) {
+    ret = 1;
+  } else {
+    uint64_t rejected_before = 0;
+    bool rejects_known = server_rejects.read(metrics_timeout, rejected_before);
+    if (!rejects_known) {
+      RCLCPP_WARN(
+        node->get_logger(), "no \"<server>: %s\" status on diagnostics, rejected requests are not counted",
+        service.c_str());
+    }
+    for (auto threads : steps) {
+      auto result = runner.run(
+        threads, std::chrono::duration<double>(duration_s), std::chrono::milliseconds(timeout_ms));
+      uint64_t rejected_after = 0;
+      // a missed read would fold this step's rejects into the next one: stop counting instead
+      rejects_known = rejects_known && server_rejects.read(metrics_timeout, rejected_after);
+      if (rejects_known) {
+        // steps run back to back, so the server's count moved only for this step's requests
+        result.rejected_known = true;
+        result.rejected = rejected_after - rejected_before;
+        result.completed -= std::min(result.completed, result.rejected);
+        rejected_before = rejected_after;
+      }
+      report(node->get_logger(), result);
+      if (!rclcpp::ok()) {
+        break;
+      }
+    }
+  }
+  executor.cancel();
+  spinner.join();
+  return ret;
+}
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = rclcpp::Node::make_shared("service_load_benchmark");
+  auto service = node->declare_parameter<std::string>("service", "add_two_ints");
+  auto steps = parse_threads(node->declare_parameter<std::string>("threads", "1,2,4,8,16,32,64"));
+  auto duration_s = node->declare_parameter<double>("duration_s", 3.0);
+  auto timeout_ms = node->declare_parameter<int>("timeout_ms", 1000);
+  // longer than the server's metrics_period_ms
+  auto metrics_timeout_ms = node->declare_parameter<int>("metrics_timeout_ms", 3000);
+  if (steps.empty()) {
+    RCLCPP_ERROR(node->get_logger(), "threads must be a comma separated list of counts");
+    return 1;
+  }
+
+  RCLCPP_INFO(node->get_logger(), "service=%s duration=%.1fs per step", service.c_str(), duration_s);
+  int ret = service == "add_three_ints" ?
+    run_all<AddThreeInts>(node, service, steps, duration_s, timeout_ms, metrics_timeout_ms) :
+    run_all<AddTwoInts>(node, service, steps, duration_s, timeout_ms, metrics_timeout_ms);
+  rclcpp::shutdown();
+  return ret;
+}
@@ -0,0 +1,221 @@
+// Offline latency breakdown for service traces (include/cpp_srvcli/service_trace.hpp).
+//
+// mkdir -p /tmp/srvtrace
+// SRVCLI_TRACE_DIR=/tmp/srvtrace ros2 run cpp_srvcli cpp_service
+// SRVCLI_TRACE_DIR=/tmp/srvtrace ros2 run cpp_srvcli cpp_client
+// ros2 run cpp_srvcli service_trace_analyzer /tmp/srvtrace
+//
+// Arguments are trace files or directories holding *.srvtrace files. Events from all files are
+// joined on (service, sequence number); requests missing a hop only count towards the hops
+// whose two ends were both recorded.
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpp_srvcli/service_trace.hpp"
+
+using cpp_srvcli::TraceEvent;
+using cpp_srvcli::TraceFileHeader;
+using cpp_srvcli::TraceRecord;
+
+namespace
+{
+
+constexpr size_t kEvents = static_cast<size_t>(TraceEvent::Count);
+
+struct Request
+{
+  std::array<uint64_t, kEvents> ts{};  // 0: not recorded
+  uint32_t duplicates = 0;             // same event seen twice: more than one client per service
+};
+
+struct Hop
+{
+  const char * name;
+  TraceEvent from;
+  TraceEvent to;
+};
+
+const Hop kHops[] = {
+  {"client queue", TraceEvent::RequestCreated, TraceEvent::RequestSent},
+  {"request transport", TraceEvent::RequestSent, TraceEvent::ServerReceived},
+  {"server dispatch", TraceEvent::ServerReceived, TraceEvent::HandlerStart},
+  {"handler", TraceEvent::HandlerStart, TraceEvent::HandlerEnd},
+  {"response send", TraceEvent::HandlerEnd, TraceEvent::ResponseSent},
+  {"response transport", TraceEvent::ResponseSent, TraceEvent::ClientReceived},
+  {"end to end", TraceEvent::RequestCreated, TraceEvent::ClientReceived},
+};
+
+using Key = std::pair<uint32_t, int64_t>;  // service id, sequence number
+
+bool ends_with(const std::string & s, const char * suffix)
+{
+  size_t n = std::strlen(suffix);
+  return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+std::vector<std::string> expand(const char * arg)
+{
+  std::vector<std::string> files;
+  DIR * dir = opendir(arg);
+  if (dir == nullptr) {
+    files.emplace_back(arg);
+    return files;
+  }
+  while (dirent * entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (ends_with(name, ".srvtrace")) {
+      files.push_back(std::string(arg) + "/" + name);
+    }
+  }
+  closedir(dir);
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+bool load(
+  const std::string & path, std::map<Key, Request> & requests,
+  std::map<uint32_t, std::string> & names)
+{
+  FILE * f = std::fopen(path.c_str(), "rb");
+  if (f == nullptr) {
+    std::fprintf(stderr, "cannot open %s\n", path.c_str());
+    return false;
+  }
+  TraceFileHeader header;
+  if (std::fread(&header, sizeof(header), 1, f) != 1 ||
+    std::memcmp(header.magic, cpp_srvcli::kTraceMagic, sizeof(header.magic)) != 0 ||
+    header.version != cpp_srvcli::kTraceVersion || header.record_size != sizeof(TraceRecord))
+  {
+    std::fprintf(stderr, "%s: not a version %u service trace\n", path.c_str(), cpp_srvcli::kTraceVersion);
+    std::fclose(f);
+    return false;
+  }
+  char process[sizeof(header.process) + 1] = {};
+  std::memcpy(process, header.process, sizeof(header.process));
+
+  size_t count = 0;
+  TraceRecord r;
+  while (std::fread(&r, sizeof(r), 1, f) == 1) {
+    if (r.event == static_cast<uint8_t>(TraceEvent::ServiceName)) {
+      // 16-character chunks of the name, chunk index in reserved[0]
+      auto & name = names[r.service];
+      size_t offset = static_cast<size_t>(r.reserved[0]) * 16;
+      if (name.size() < offset + 16) {
+        name.resize(offset + 16, '\0');
+      }
+      std::memcpy(&name[offset], &r, 16);
+      continue;
+    }
+    if (r.event >= kEvents) {
+      continue;
+    }
+    auto & request = requests[Key(r.service, r.sequence)];
+    auto & slot = request.ts[r.event];
+    if (slot != 0) {
+      ++request.duplicates;
+    }
+    slot = r.timestamp_ns;
+    ++count;
+  }
+  std::fclose(f);
+  for (auto & entry : names) {
+    auto end = entry.second.find('\0');
+    if (end != std::string::npos) {
+      entry.second.erase(end);
+    }
+  }
+  std::printf("%s: %s (pid %d), %zu events\n", path.c_str(), process, header.pid, count);
+  return true;
+}
+
+double percentile(const std::vector<double> & sorted, double q)
+{
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  size_t i = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+  return sorted[std::min(i, sorted.size() - 1)];
+}
+
+void report(const std::string & service, const std::vector<const Request *> & requests)
+{
+  size_t duplicates = 0;
+  for (auto r : requests) {
+    duplicates += r->duplicates > 0 ? 1 : 0;
+  }
+  std::printf("\n%s: %zu requests\n", service.c_str(), requests.size());
+  if (duplicates > 0) {
+    std::printf(
+      "  warning: %zu sequence numbers seen twice; trace one client per service for exact joins\n",
+      duplicates);
+  }
+  std::printf(
+    "  %-20s %8s %10s %10s %10s %10s %10s\n", "hop (us)", "n", "mean", "p50", "p90", "p99", "max");
+  for (const auto & hop : kHops) {
+    std::vector<double> us;
+    for (auto r : requests) {
+      uint64_t a = r->ts[static_cast<size_t>(hop.from)];
+      uint64_t b = r->ts[static_cast<size_t>(hop.to)];
+      if (a != 0 && b != 0 && b >= a) {
+        us.push_back(static_cast<double>(b - a) / 1000.0);
+      }
+    }
+    if (us.empty()) {
+      std::printf("  %-20s %8s\n", hop.name, "-");
+      continue;
+    }
+    std::sort(us.begin(), us.end());
+    double sum = 0.0;
+    for (auto v : us) {
+      sum += v;
+    }
+    std::printf(
+      "  %-20s %8zu %10.1f %10.1f %10.1f %10.1f %10.1f\n", hop.name, us.size(),
+      sum / static_cast<double>(us.size()), percentile(us, 0.5), percentile(us, 0.9),
+      percentile(us, 0.99), us.back());
+  }
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: service_trace_analyzer <trace file or directory>...\n");
+    return 1;
+  }
+  std::map<Key, Request> requests;
+  std::map<uint32_t, std::string> names;
+  size_t loaded = 0;
+  for (int i = 1; i < argc; ++i) {
+    for (const auto & path : expand(argv[i])) {
+      loaded += load(path, requests, names) ? 1 : 0;
+    }
+  }
+  if (loaded == 0) {
+    std::fprintf(stderr, "no trace files loaded\n");
+    return 1;
+  }
+
+  std::map<uint32_t, std::vector<const Request *>> by_service;
+  for (const auto & entry : requests) {
+    by_service[entry.first.first].push_back(&entry.second);
+  }
+  for (const auto & entry : by_service) {
+    auto name = names.find(entry.first);
+    char id[16];
+    std::snprintf(id, sizeof(id), "0x%08x", entry.first);
+    report(name != names.end() ? name->second : id, entry.second);
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+// Performance regression gate (ctest label "perf") for the AddTwoInts server path:
+//  - add_two_ints_dispatch: AnyServiceCallback dispatch of cpp_srvcli::add (the server's handler,
+//    INFO logging switched off), response allocated per request as Service::handle_request does
+//    (no middleware)
+//  - add_two_ints_round_trip: client -> TracedService -> client on one node and one executor
+//    (a macro benchmark through the middleware; set SRVCLI_TRACE_DIR only when tracing is wanted)
+// Results are compared with test/perf_baseline.json, see tutorial_utils/perf_gate.hpp.
+//
+// Built only with -DPERF_GATE=ON. Record a baseline on this host:
+//   PERF_GATE_UPDATE=1 colcon test --packages-select cpp_srvcli --ctest-args -L perf
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rcutils/logging.h"
+#include "example_interfaces/srv/add_two_ints.hpp"
+#include "cpp_srvcli/add_two_ints.hpp"
+#include "cpp_srvcli/traced_service.hpp"
+#include "tutorial_utils/perf_gate.hpp"
+
+using AddTwoInts = example_interfaces::srv::AddTwoInts;
+
+namespace
+{
+
+tutorial_utils::PerfGate & gate()
+{
+  static tutorial_utils::PerfGate instance(PERF_BASELINE_PATH);
+  return instance;
+}
+
+volatile int64_t g_sink = 0;
+
+}  // namespace
+
+class SrvcliPerf : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+    // add() logs every request at INFO; measure the handler, not the console
+    rcutils_logging_set_logger_level("rclcpp", RCUTILS_LOG_SEVERITY_WARN);
+  }
+  static void TearDownTestCase() {rclcpp::shutdown();}
+};
+
+TEST_F(SrvcliPerf, add_two_ints_dispatch)
+{
+  if (gate().disabled()) {
+    return;
+  }
+  rclcpp::AnyServiceCallback<AddTwoInts> callback;
+  callback.set(&cpp_srvcli::add);
+  auto header = std::make_shared<rmw_request_id_t>();
+  auto request = std::make_shared<AddTwoInts::Request>();
+  request->a = 2;
+  request->b = 3;
+  auto result = tutorial_utils::run_benchmark(
+    "add_two_ints_dispatch", [&](uint64_t n) {
+      for (uint64_t i = 0; i < n; ++i) {
+        auto response = std::make_shared<AddTwoInts::Response>();
+        callback.dispatch(header, request, response);
+        g_sink = response->sum;
+      }
+    });
+  auto verdict = gate().check(result);
+  EXPECT_TRUE(verdict.passed()) << verdict.message;
+}
+
+TEST_F(SrvcliPerf, add_two_ints_round_trip)
+{
+  if (gate().disabled()) {
+    return;
+  }
+  auto node = rclcpp::Node::make_shared("srvcli_perf");
+  auto service = cpp_srvcli::create_traced_service<AddTwoInts>(node, "perf_add_two_ints", &cpp_srvcli::add);
+  auto client = node->create_client<AddTwoInts>("perf_add_two_ints");
+  ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(5)));
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+
+  auto request = std::make_shared<AddTwoInts::Request>();
+  request->a = 2;
+  request->b = 3;
+  bool ok = true;
+  tutorial_utils::PerfOptions options;
+  options.min_repetition_ms = 20.0;  // tens of microseconds per call: keep batches long enough to average
+  auto result = tutorial_utils::run_benchmark(
+    "add_two_ints_round_trip", [&](uint64_t n) {
+      for (uint64_t i = 0; i < n && ok; ++i) {
+        auto future = client->async_send_request(request);
+        ok = executor.spin_until_future_complete(future, std::chrono::seconds(5)) ==
+          rclcpp::FutureReturnCode::SUCCESS;
+        g_sink = ok ? future.get()->sum : 0;
+      }
+    }, options);
+  ASSERT_TRUE(ok) << "request timed out";
+  auto verdict = gate().check(result);
+  EXPECT_TRUE(verdict.passed()) << verdict.message;
+}
@@ -0,0 +1,28 @@
+import os
+
+from ament_index_python.packages import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, OpaqueFunction
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+
+
+# ros2 launch more_interfaces address_book_launch.py transport:=shm
+def launch_setup(context):
+    transport = LaunchConfiguration('transport').perform(context)
+    env = dict(os.environ)
+    env['RMW_IMPLEMENTATION'] = 'rmw_fastrtps_cpp'
+    env['FASTRTPS_DEFAULT_PROFILES_FILE'] = os.path.join(
+        get_package_share_directory('more_interfaces'),
+        'config', 'fastdds_{}.xml'.format(transport))
+    return [
+        Node(package='more_interfaces', executable='publish_address_book', output='screen', env=env),
+        Node(package='more_interfaces', executable='subscribe_address_book', output='screen', env=env),
+    ]
+
+
+def generate_launch_description():
+    return LaunchDescription([
+        DeclareLaunchArgument('transport', default_value='shm', description='shm or udp'),
+        OpaqueFunction(function=launch_setup),
+    ])
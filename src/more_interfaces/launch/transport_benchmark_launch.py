@@ -0,0 +1,52 @@
+import os
+
+from ament_index_python.packages import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, OpaqueFunction, Shutdown
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+
+
+# ros2 launch more_interfaces transport_benchmark_launch.py transport:=shm payload:=address_book
+# ros2 launch more_interfaces transport_benchmark_launch.py transport:=udp payload:=fibonacci
+def launch_setup(context):
+    transport = LaunchConfiguration('transport').perform(context)
+    payload = LaunchConfiguration('payload').perform(context)
+    iterations = int(LaunchConfiguration('iterations').perform(context))
+    profile = os.path.join(
+        get_package_share_directory('more_interfaces'),
+        'config', 'fastdds_{}.xml'.format(transport))
+    env = dict(os.environ)
+    env['RMW_IMPLEMENTATION'] = 'rmw_fastrtps_cpp'
+    env['FASTRTPS_DEFAULT_PROFILES_FILE'] = profile
+
+    parameters = [{'payload': payload, 'iterations': iterations}]
+    return [
+        Node(
+            package='more_interfaces',
+            executable='transport_benchmark',
+            name='transport_benchmark_pong',
+            output='screen',
+            parameters=[{'role': 'pong', 'payload': payload}],
+            env=env,
+        ),
+        Node(
+            package='more_interfaces',
+            executable='transport_benchmark',
+            name='transport_benchmark_ping',
+            output='screen',
+            parameters=[{'role': 'ping'}] + parameters,
+            env=env,
+            on_exit=Shutdown(),
+        ),
+    ]
+
+
+def generate_launch_description():
+    return LaunchDescription([
+        DeclareLaunchArgument('transport', default_value='shm', description='shm or udp'),
+        DeclareLaunchArgument(
+            'payload', default_value='address_book', description='address_book or fibonacci'),
+        DeclareLaunchArgument('iterations', default_value='20'),
+        OpaqueFunction(function=launch_setup),
+    ])
@@ -0,0 +1,130 @@
+// aggregate_subscriber：一个节点同时订阅 chatter(String)、topic(Num)、contact(Contact)、address_book(AddressBook)，
+// 用 tutorial_utils::SubscriberSet 在编译期注册四个处理函数（const T& 参数，不经过 std::bind），
+// 每 summary_period_ms 打印一次各类型的计数。
+//
+// dispatch.mode：
+//  - executor（默认）：照常 spin，rclcpp 对每个订阅调用一次注册的 lambda
+//  - wait_set：节点不加入执行器，主循环等待 WaitSet 后 take_all()，消息取到预分配的对象里直接调用处理函数
+//
+// ros2 run more_interfaces aggregate_subscriber --ros-args -p dispatch.mode:=wait_set
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "tutorial_interfaces/msg/contact.hpp"
+#include "tutorial_interfaces/msg/num.hpp"
+#include "more_interfaces/msg/address_book.hpp"
+#include "tutorial_utils/startup.hpp"
+#include "tutorial_utils/subscriber_set.hpp"
+
+using tutorial_utils::on;
+
+class AggregateSubscriber : public rclcpp::Node
+{
+public:
+  AggregateSubscriber()
+  : Node("aggregate_subscriber")
+  {
+    wait_set_mode_ = this->declare_parameter<std::string>("dispatch.mode", "executor") == "wait_set";
+    summary_period_ = std::chrono::milliseconds(this->declare_parameter<int>("summary_period_ms", 1000));
+
+    set_ = tutorial_utils::make_subscriber_set(
+      *this, rclcpp::QoS(10),
+      on<std_msgs::msg::String>(
+        "chatter", [this](const std_msgs::msg::String & msg) {
+          ++counts_.strings;
+          counts_.string_bytes += msg.data.size();
+        }),
+      on<tutorial_interfaces::msg::Num>(
+        "topic", [this](const tutorial_interfaces::msg::Num & msg) {
+          ++counts_.nums;
+          counts_.last_num = msg.num;
+        }),
+      on<tutorial_interfaces::msg::Contact>(
+        "contact", [this](const tutorial_interfaces::msg::Contact & msg) {
+          ++counts_.contacts;
+          ++counts_.phone_types[msg.phone_type % 3];
+        }),
+      on<more_interfaces::msg::AddressBook>(
+        "address_book", [this](const more_interfaces::msg::AddressBook & msg) {
+          tutorial_utils::StartupProfiler::instance().finish("first_message", this->get_logger());
+          ++counts_.address_books;
+          ++counts_.phone_types[msg.phone_type % 3];
+        }));
+
+    // wait_set 模式下节点不被 spin，定时器不会触发，摘要由主循环打印
+    if (!wait_set_mode_) {
+      summary_timer_ = this->create_wall_timer(summary_period_, [this]() {print_summary();});
+    }
+  }
+
+  // 节点不加入执行器，在当前线程里等待并取消息，直到 rclcpp 关闭
+  void run_wait_set()
+  {
+    rclcpp::WaitSet wait_set;
+    set_->add_to(wait_set);
+    auto next_summary = std::chrono::steady_clock::now() + summary_period_;
+    while (rclcpp::ok()) {
+      if (wait_set.wait(std::chrono::milliseconds(100)).kind() == rclcpp::WaitResultKind::Ready) {
+        set_->take_all();
+      }
+      if (std::chrono::steady_clock::now() >= next_summary) {
+        print_summary();
+        next_summary += summary_period_;
+      }
+    }
+  }
+
+  bool wait_set_mode() const {return wait_set_mode_;}
+
+private:
+  void print_summary()
+  {
+    RCLCPP_INFO(
+      this->get_logger(),
+      "strings:%lu (%lu bytes) nums:%lu (last %ld) contacts:%lu address_books:%lu "
+      "phone_type home/work/mobile:%lu/%lu/%lu",
+      static_cast<unsigned long>(counts_.strings), static_cast<unsigned long>(counts_.string_bytes),
+      static_cast<unsigned long>(counts_.nums), static_cast<long>(counts_.last_num),
+      static_cast<unsigned long>(counts_.contacts), static_cast<unsigned long>(counts_.address_books),
+      static_cast<unsigned long>(counts_.phone_types[0]), static_cast<unsigned long>(counts_.phone_types[1]),
+      static_cast<unsigned long>(counts_.phone_types[2]));
+  }
+
+  struct Counts
+  {
+    uint64_t strings = 0;
+    uint64_t string_bytes = 0;
+    uint64_t nums = 0;
+    int64_t last_num = 0;
+    uint64_t contacts = 0;
+    uint64_t address_books = 0;
+    uint64_t phone_types[3] = {0, 0, 0};
+  };
+
+  Counts counts_;
+  // 具体类型取决于各个 lambda，成员只保存基类指针（只有 take_all/add_to 经过虚函数）
+  std::unique_ptr<tutorial_utils::SubscriberSetBase> set_;
+  bool wait_set_mode_ = false;
+  std::chrono::milliseconds summary_period_;
+  rclcpp::TimerBase::SharedPtr summary_timer_;
+};
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  tutorial_utils::startup_mark("init");
+  auto node = std::make_shared<AggregateSubscriber>();
+  tutorial_utils::startup_mark("node");
+  if (node->wait_set_mode()) {
+    node->run_wait_set();
+  } else {
+    rclcpp::spin(node);
+  }
+  rclcpp::shutdown();
+  return 0;
+}
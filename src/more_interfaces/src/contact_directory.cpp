@@ -0,0 +1,190 @@
+// contact_directory：从 address_book（单条）和 address_book_batch（批量）话题增量维护内存中的联系人目录
+// （tutorial_utils::ContactDirectory：电话号码开放寻址哈希、姓的有序索引、phone_type 并行扫描），
+// 并提供 query_contacts 服务（more_interfaces/srv/QueryContacts）。
+//
+// 参数：
+//  - directory.threads：phone_type 扫描的线程数，0 = CPU 核数
+//  - directory.synthetic：启动时预先写入的合成联系人数，用来在大规模目录上试查询
+//
+// 订阅和服务在不同的回调组里，由多线程执行器调度：写入期间查询只在目录的读写锁上等待。
+//
+// ros2 run more_interfaces contact_directory --ros-args -p directory.synthetic:=2000000
+// ros2 service call /query_contacts more_interfaces/srv/QueryContacts "{kind: 1, key: 'Mar', max_results: 5}"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "rclcpp/rclcpp.hpp"
+#include "more_interfaces/msg/address_book.hpp"
+#include "more_interfaces/msg/address_book_batch.hpp"
+#include "more_interfaces/srv/query_contacts.hpp"
+#include "tutorial_utils/contact_directory.hpp"
+#include "tutorial_utils/startup.hpp"
+
+using namespace std::chrono_literals;
+using AddressBook = more_interfaces::msg::AddressBook;
+using AddressBookBatch = more_interfaces::msg::AddressBookBatch;
+using QueryContacts = more_interfaces::srv::QueryContacts;
+
+namespace
+{
+
+tutorial_utils::ContactRecord to_record(const AddressBook & msg)
+{
+  tutorial_utils::ContactRecord record;
+  record.first_name = msg.first_name;
+  record.last_name = msg.last_name;
+  record.phone_number = msg.phone_number;
+  record.phone_type = msg.phone_type;
+  return record;
+}
+
+AddressBook to_msg(const tutorial_utils::ContactRecord & record)
+{
+  AddressBook msg;
+  msg.first_name = record.first_name;
+  msg.last_name = record.last_name;
+  msg.phone_number = record.phone_number;
+  msg.phone_type = record.phone_type;
+  return msg;
+}
+
+}  // namespace
+
+class ContactDirectoryNode : public rclcpp::Node
+{
+public:
+  ContactDirectoryNode()
+  : Node("contact_directory")
+  {
+    tutorial_utils::ContactDirectory::Options options;
+    auto threads = this->declare_parameter<int>("directory.threads", 0);
+    if (threads > 0) {
+      options.threads = static_cast<size_t>(threads);
+    }
+    directory_ = std::make_unique<tutorial_utils::ContactDirectory>(options);
+
+    auto synthetic = this->declare_parameter<int>("directory.synthetic", 0);
+    if (synthetic > 0) {
+      auto start = std::chrono::steady_clock::now();
+      directory_->reserve(static_cast<size_t>(synthetic));
+      for (int64_t i = 0; i < synthetic; ++i) {
+        directory_->upsert(tutorial_utils::synthetic_contact(static_cast<uint64_t>(i)));
+      }
+      RCLCPP_INFO(
+        this->get_logger(), "loaded %ld synthetic contacts in %.2f s", static_cast<long>(synthetic),
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // 写入（两个订阅）和查询（服务）各用一个回调组，多线程执行器下可以并行
+    // Foxy 的拼写（rclcpp::callback_group::），Galactic 起为 rclcpp::CallbackGroupType
+    using rclcpp::callback_group::CallbackGroupType;
+    ingest_group_ = this->create_callback_group(CallbackGroupType::MutuallyExclusive);
+    query_group_ = this->create_callback_group(CallbackGroupType::MutuallyExclusive);
+    rclcpp::SubscriptionOptions ingest_options;
+    ingest_options.callback_group = ingest_group_;
+
+    address_book_sub_ = this->create_subscription<AddressBook>(
+      "address_book", rclcpp::QoS(100),
+      [this](const AddressBook::SharedPtr msg) {
+        tutorial_utils::StartupProfiler::instance().finish("first_message", this->get_logger());
+        directory_->upsert(to_record(*msg));
+        ++ingested_;
+      },
+      ingest_options);
+    batch_sub_ = this->create_subscription<AddressBookBatch>(
+      "address_book_batch", rclcpp::QoS(10),
+      [this](const AddressBookBatch::SharedPtr msg) {
+        for (const auto & entry : msg->entries) {
+          directory_->upsert(to_record(entry));
+        }
+        ingested_ += msg->entries.size();
+      },
+      ingest_options);
+
+    service_ = this->create_service<QueryContacts>(
+      "query_contacts",
+      [this](
+        const std::shared_ptr<QueryContacts::Request> request,
+        std::shared_ptr<QueryContacts::Response> response) {handle_query(*request, *response);},
+      rmw_qos_profile_services_default, query_group_);
+
+    stats_timer_ = this->create_wall_timer(5s, [this]() {log_stats();}, ingest_group_);
+  }
+
+private:
+  void handle_query(const QueryContacts::Request & request, QueryContacts::Response & response)
+  {
+    auto start = std::chrono::steady_clock::now();
+    tutorial_utils::ContactDirectory::QueryResult result;
+    switch (request.kind) {
+      case QueryContacts::Request::QUERY_PHONE: {
+          tutorial_utils::ContactRecord record;
+          if (directory_->find_phone(request.key, record)) {
+            result.total = 1;
+            result.contacts.push_back(std::move(record));
+          }
+          break;
+        }
+      case QueryContacts::Request::QUERY_LAST_NAME_PREFIX:
+        result = directory_->last_name_prefix(request.key, request.max_results);
+        break;
+      case QueryContacts::Request::QUERY_PHONE_TYPE:
+        result = directory_->phone_type(request.phone_type, request.max_results);
+        break;
+      default:
+        RCLCPP_WARN(this->get_logger(), "unknown query kind %d", request.kind);
+        break;
+    }
+    response.query_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    response.total_matches = result.total;
+    response.directory_size = directory_->size();
+    response.contacts.reserve(result.contacts.size());
+    for (const auto & record : result.contacts) {
+      response.contacts.push_back(to_msg(record));
+    }
+  }
+
+  void log_stats()
+  {
+    auto stats = directory_->stats();
+    uint64_t ingested = ingested_;
+    if (ingested == last_ingested_ && stats.contacts == last_contacts_) {
+      return;
+    }
+    RCLCPP_INFO(
+      this->get_logger(), "contacts:%zu ingested:%lu (+%lu) runs:%zu stale:%zu hash_capacity:%zu",
+      stats.contacts, static_cast<unsigned long>(ingested), static_cast<unsigned long>(ingested - last_ingested_),
+      stats.runs, stats.stale, stats.hash_capacity);
+    last_ingested_ = ingested;
+    last_contacts_ = stats.contacts;
+  }
+
+  std::unique_ptr<tutorial_utils::ContactDirectory> directory_;
+  rclcpp::callback_group::CallbackGroup::SharedPtr ingest_group_;
+  rclcpp::callback_group::CallbackGroup::SharedPtr query_group_;
+  rclcpp::Subscription<AddressBook>::SharedPtr address_book_sub_;
+  rclcpp::Subscription<AddressBookBatch>::SharedPtr batch_sub_;
+  rclcpp::Service<QueryContacts>::SharedPtr service_;
+  rclcpp::TimerBase::SharedPtr stats_timer_;
+  uint64_t ingested_ = 0;  // 只在写入回调组里修改
+  uint64_t last_ingested_ = 0;
+  size_t last_contacts_ = 0;
+};
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  tutorial_utils::startup_mark("init");
+  auto node = std::make_shared<ContactDirectoryNode>();
+  tutorial_utils::startup_mark("node");
+  rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(), 2);
+  executor.add_node(node);
+  executor.spin();
+  rclcpp::shutdown();
+  return 0;
+}
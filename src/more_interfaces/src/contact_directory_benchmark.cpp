@@ -0,0 +1,147 @@
+// contact_directory_benchmark：tutorial_utils::ContactDirectory 的写入速率和查询延迟（不经过 ROS，只测索引本身）。
+//  1. 写入：逐条 upsert N 个合成联系人（synthetic_contact），再对其中 10% 做更新（其中一半改姓），报告每秒条数
+//  2. 查询：对每种查询各执行若干次，报告 p50 / p99 / max（微秒）
+//     - phone：按电话号码精确查找（随机命中）
+//     - prefix：姓的前缀查询，max_results=100，前缀长度 1..4 轮换
+//     - phone_type：按类型扫描，max_results=100，total 为全部匹配数；按线程数 1, 2, 4 ... threads 分别测
+//
+// ros2 run more_interfaces contact_directory_benchmark [联系人数，默认 2000000] [最大线程数，默认 CPU 核数]
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tutorial_utils/contact_directory.hpp"
+
+using tutorial_utils::ContactDirectory;
+using tutorial_utils::ContactRecord;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Latency
+{
+  double p50 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+Latency summarize(std::vector<double> & us)
+{
+  Latency latency;
+  if (us.empty()) {
+    return latency;
+  }
+  std::sort(us.begin(), us.end());
+  latency.p50 = us[us.size() / 2];
+  latency.p99 = us[std::min(us.size() - 1, us.size() * 99 / 100)];
+  latency.max = us.back();
+  return latency;
+}
+
+// query() 执行 iterations 次，每次单独计时
+template<typename Query>
+Latency measure(size_t iterations, Query query)
+{
+  std::vector<double> us;
+  us.reserve(iterations);
+  for (size_t i = 0; i < iterations; ++i) {
+    auto start = Clock::now();
+    query(i);
+    us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+  }
+  return summarize(us);
+}
+
+// 防止编译器把查询结果优化掉
+volatile uint64_t g_sink = 0;
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  size_t contacts = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+  size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) :
+    std::max(1u, std::thread::hardware_concurrency());
+  if (contacts == 0 || max_threads == 0) {
+    std::fprintf(stderr, "usage: contact_directory_benchmark [contacts > 0] [max threads > 0]\n");
+    return 1;
+  }
+
+  // 预先生成，写入计时不含字符串构造
+  std::vector<ContactRecord> input;
+  input.reserve(contacts);
+  for (size_t i = 0; i < contacts; ++i) {
+    input.push_back(tutorial_utils::synthetic_contact(i));
+  }
+  std::vector<ContactRecord> updates;
+  std::mt19937_64 rng(7);
+  for (size_t i = 0; i < contacts / 10; ++i) {
+    auto record = input[rng() % contacts];
+    if (i % 2 == 0) {
+      record.last_name = tutorial_utils::synthetic_contact(rng() % contacts).last_name;
+    }
+    record.phone_type = static_cast<uint8_t>((record.phone_type + 1) % 3);
+    updates.push_back(record);
+  }
+  std::vector<std::string> phones;
+  for (size_t i = 0; i < 10000; ++i) {
+    phones.push_back(input[rng() % contacts].phone_number);
+  }
+  std::vector<std::string> prefixes;
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto & last = input[rng() % contacts].last_name;
+    prefixes.push_back(last.substr(0, 1 + i % 4));
+  }
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    ContactDirectory::Options options;
+    options.threads = threads;
+    ContactDirectory directory(options);
+
+    auto start = Clock::now();
+    for (const auto & record : input) {
+      directory.upsert(record);
+    }
+    double insert_s = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (const auto & record : updates) {
+      directory.upsert(record);
+    }
+    double update_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    auto phone = measure(
+      phones.size(), [&](size_t i) {
+        ContactRecord found;
+        g_sink = g_sink + (directory.find_phone(phones[i], found) ? 1 : 0);
+      });
+    auto prefix = measure(
+      prefixes.size(), [&](size_t i) {
+        g_sink = g_sink + directory.last_name_prefix(prefixes[i], 100).total;
+      });
+    auto type = measure(
+      300, [&](size_t i) {
+        g_sink = g_sink + directory.phone_type(static_cast<uint8_t>(i % 3), 100).total;
+      });
+
+    auto stats = directory.stats();
+    std::printf(
+      "contact_directory: contacts=%zu threads=%zu insert_per_s=%.0f update_per_s=%.0f runs=%zu "
+      "phone_us_p50=%.2f phone_us_p99=%.2f prefix_us_p50=%.1f prefix_us_p99=%.1f prefix_us_max=%.1f "
+      "phone_type_us_p50=%.1f phone_type_us_p99=%.1f phone_type_us_max=%.1f\n",
+      stats.contacts, threads, static_cast<double>(input.size()) / insert_s,
+      static_cast<double>(updates.size()) / update_s, stats.runs,
+      phone.p50, phone.p99, prefix.p50, prefix.p99, prefix.max, type.p50, type.p99, type.max);
+    std::fflush(stdout);
+  }
+  return 0;
+}
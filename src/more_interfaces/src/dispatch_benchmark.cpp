@@ -0,0 +1,211 @@
+// dispatch_benchmark：多类型订阅的分发开销，std::bind 写法 vs tutorial_utils::SubscriberSet。
+// 四种消息（String、Num、Contact、AddressBook）轮流分发，处理函数做相同的少量工作，测每条消息的平均耗时：
+//  - bind：Listener / AddressBookSubscriber 的写法，std::bind 成员函数存进 std::function，
+//          按 rclcpp 的方式以值传递 shared_ptr 调用（每条消息一次原子引用计数加减）
+//  - set_executor：SubscriberSet 在执行器模式下 rclcpp 持有的那一层：std::function + shared_ptr<const T>，
+//          处理函数拿 const T&
+//  - set_direct：SubscriberSet::dispatch，即 take_all() 路径，没有类型擦除，也没有 shared_ptr
+// 多线程时所有线程分发同一批消息（同一个 shared_ptr），引用计数所在的缓存行在核间争用。
+// 只测分发，不含 rmw 取消息和反序列化。
+//
+// ros2 run more_interfaces dispatch_benchmark --ros-args -p threads:=4 -p min_ms:=300
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "tutorial_interfaces/msg/contact.hpp"
+#include "tutorial_interfaces/msg/num.hpp"
+#include "more_interfaces/msg/address_book.hpp"
+#include "tutorial_utils/subscriber_set.hpp"
+
+using std::placeholders::_1;
+using tutorial_utils::on;
+using String = std_msgs::msg::String;
+using Num = tutorial_interfaces::msg::Num;
+using Contact = tutorial_interfaces::msg::Contact;
+using AddressBook = more_interfaces::msg::AddressBook;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// 每个线程一个（按缓存行对齐，避免线程间伪共享），处理函数的工作量与 aggregate_subscriber 相同
+struct alignas(64) Sink
+{
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+  int64_t last = 0;
+  uint64_t phone_types[3] = {0, 0, 0};
+
+  void on_string(const String::SharedPtr msg) {++count; bytes += msg->data.size();}
+  void on_num(const Num::SharedPtr msg) {++count; last = msg->num;}
+  void on_contact(const Contact::SharedPtr msg) {++count; ++phone_types[msg->phone_type % 3];}
+  void on_address_book(const AddressBook::SharedPtr msg) {++count; ++phone_types[msg->phone_type % 3];}
+};
+
+struct Messages
+{
+  std::shared_ptr<String> string = std::make_shared<String>();
+  std::shared_ptr<Num> num = std::make_shared<Num>();
+  std::shared_ptr<Contact> contact = std::make_shared<Contact>();
+  std::shared_ptr<AddressBook> address_book = std::make_shared<AddressBook>();
+};
+
+// 每条消息的平均耗时（ns）：round(messages) 分发 4 条消息，重复直到超过 min_ms，取 threads 个线程的平均。
+// round 在主线程里创建（SubscriberSet 要在节点上建订阅），每个线程一个 Sink。
+template<typename MakeRound>
+double measure(size_t threads, double min_ms, const Messages & messages, MakeRound make_round)
+{
+  std::vector<Sink> sinks(threads);
+  using Round = decltype(make_round(sinks[0]));
+  std::vector<Round> rounds;
+  rounds.reserve(threads);
+  for (auto & sink : sinks) {
+    rounds.push_back(make_round(sink));
+  }
+
+  std::vector<double> ns_per_msg(threads, 0.0);
+  std::atomic<size_t> ready{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back(
+      [&, t]() {
+        auto & round = rounds[t];
+        ++ready;
+        while (!go.load()) {
+        }
+        uint64_t calls = 0;
+        auto start = Clock::now();
+        double elapsed_ns = 0.0;
+        while (elapsed_ns < min_ms * 1e6) {
+          for (int i = 0; i < 1024; ++i) {
+            round(messages);
+          }
+          calls += 1024 * 4;
+          elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+        ns_per_msg[t] = elapsed_ns / static_cast<double>(calls);
+      });
+  }
+  while (ready.load() < threads) {
+  }
+  go = true;
+  for (auto & worker : workers) {
+    worker.join();
+  }
+  double sum = 0.0;
+  for (size_t t = 0; t < threads; ++t) {
+    if (sinks[t].count == 0) {
+      std::fprintf(stderr, "dispatch: thread %zu handled no messages\n", t);
+    }
+    sum += ns_per_msg[t];
+  }
+  return sum / static_cast<double>(threads);
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<rclcpp::Node>("dispatch_benchmark");
+  auto max_threads = static_cast<size_t>(std::max(node->declare_parameter<int>("threads", 4), 1));
+  auto min_ms = node->declare_parameter<double>("min_ms", 300.0);
+
+  Messages messages;
+  messages.string->data = "Hello, world! 1700000000.000000000 42";
+  messages.num->num = 42;
+  messages.contact->first_name = "John";
+  messages.contact->last_name = "Doe";
+  messages.contact->phone_number = "1234567890";
+  messages.contact->phone_type = Contact::PHONE_TYPE_MOBILE;
+  messages.address_book->first_name = "Jane";
+  messages.address_book->last_name = "Doe";
+  messages.address_book->phone_number = "4254242424";
+  messages.address_book->phone_type = AddressBook::PHONE_TYPE_HOME;
+
+  // std::bind 写法，调用方式同 rclcpp：std::function 以值接收 shared_ptr
+  auto bind_round = [](Sink & sink) {
+      std::function<void(const String::SharedPtr)> f_string = std::bind(&Sink::on_string, &sink, _1);
+      std::function<void(const Num::SharedPtr)> f_num = std::bind(&Sink::on_num, &sink, _1);
+      std::function<void(const Contact::SharedPtr)> f_contact = std::bind(&Sink::on_contact, &sink, _1);
+      std::function<void(const AddressBook::SharedPtr)> f_book =
+        std::bind(&Sink::on_address_book, &sink, _1);
+      return [f_string, f_num, f_contact, f_book](const Messages & m) {
+               f_string(m.string);
+               f_num(m.num);
+               f_contact(m.contact);
+               f_book(m.address_book);
+             };
+    };
+
+  // 每个 Sink 一个 SubscriberSet，订阅建在同一个节点的不同话题上，不会真的收到消息
+  int topic_id = 0;
+  auto make_set = [&node, &topic_id](Sink & sink) {
+      auto prefix = "dispatch_benchmark_" + std::to_string(topic_id++) + "_";
+      auto set = tutorial_utils::make_subscriber_set(
+        *node, rclcpp::QoS(1),
+        on<String>(prefix + "string", [&sink](const String & msg) {++sink.count; sink.bytes += msg.data.size();}),
+        on<Num>(prefix + "num", [&sink](const Num & msg) {++sink.count; sink.last = msg.num;}),
+        on<Contact>(
+          prefix + "contact", [&sink](const Contact & msg) {++sink.count; ++sink.phone_types[msg.phone_type % 3];}),
+        on<AddressBook>(
+          prefix + "address_book",
+          [&sink](const AddressBook & msg) {++sink.count; ++sink.phone_types[msg.phone_type % 3];}));
+      return std::shared_ptr<typename decltype(set)::element_type>(std::move(set));
+    };
+
+  // 执行器模式下 rclcpp 持有的那一层：std::function 以值接收 shared_ptr<const T>
+  auto set_executor_round = [&make_set](Sink & sink) {
+      auto set = make_set(sink);
+      std::function<void(std::shared_ptr<const String>)> f_string =
+        [set](std::shared_ptr<const String> msg) {set->dispatch(*msg);};
+      std::function<void(std::shared_ptr<const Num>)> f_num =
+        [set](std::shared_ptr<const Num> msg) {set->dispatch(*msg);};
+      std::function<void(std::shared_ptr<const Contact>)> f_contact =
+        [set](std::shared_ptr<const Contact> msg) {set->dispatch(*msg);};
+      std::function<void(std::shared_ptr<const AddressBook>)> f_book =
+        [set](std::shared_ptr<const AddressBook> msg) {set->dispatch(*msg);};
+      return [f_string, f_num, f_contact, f_book](const Messages & m) {
+               f_string(m.string);
+               f_num(m.num);
+               f_contact(m.contact);
+               f_book(m.address_book);
+             };
+    };
+
+  // take_all() 路径：直接 dispatch
+  auto set_direct_round = [&make_set](Sink & sink) {
+      auto set = make_set(sink);
+      return [set](const Messages & m) {
+               set->dispatch(*m.string);
+               set->dispatch(*m.num);
+               set->dispatch(*m.contact);
+               set->dispatch(*m.address_book);
+             };
+    };
+
+  std::printf("dispatch: ns per message\n");
+  std::printf("dispatch: %7s %9s %15s %13s\n", "threads", "bind", "set_executor", "set_direct");
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    double bind_ns = measure(threads, min_ms, messages, bind_round);
+    double set_executor_ns = measure(threads, min_ms, messages, set_executor_round);
+    double set_direct_ns = measure(threads, min_ms, messages, set_direct_round);
+    std::printf("dispatch: %7zu %9.2f %15.2f %13.2f\n", threads, bind_ns, set_executor_ns, set_direct_ns);
+    std::fflush(stdout);
+  }
+  rclcpp::shutdown();
+  return 0;
+}
@@ -3,6 +3,8 @@
 #include <memory> // 用于智能指针，如std::shared_ptr
 #include "rclcpp/rclcpp.hpp" // ROS2的C++客户端库核心功能
 #include "more_interfaces/msg/address_book.hpp" // 自定义消息类型
+#include "tutorial_utils/pool_memory_strategy.hpp" // 内存池分配器和执行器内存策略
+#include "tutorial_utils/startup.hpp" // 启动阶段计时
 
 // #include "tutorial_interfaces/msg/contact.hpp"     // CHANGE  测试失败 20250325
 
@@ -16,9 +18,13 @@ public:
   AddressBookPublisher()
   : Node("address_book_publisher") // 调用基类构造函数，设置节点名
   {
+    // 内存池（memory.pool:=true 开启）：发布者和执行器内存从内存池分配
+    pool_ = tutorial_utils::declare_pool_parameters(*this);
+    pool_stats_timer_ = tutorial_utils::enable_pool(*this, pool_);
+
     // 创建一个发布者，发布到"address_book"话题，消息类型为AddressBook，队列大小10
-    address_book_publisher_ =
-      this->create_publisher<more_interfaces::msg::AddressBook>("address_book", 10);
+    address_book_publisher_ = this->create_publisher<more_interfaces::msg::AddressBook>(
+      "address_book", 10, tutorial_utils::pool_publisher_options());
 
     // 定义发布消息的lambda函数
     auto publish_msg = [this]() -> void {
@@ -38,6 +44,7 @@ public:
         << std::endl;
         // 发布消息
         this->address_book_publisher_->publish(message);
+        tutorial_utils::StartupProfiler::instance().finish("first_publish", this->get_logger());
         
         // // CHANGE; using an existing message type to fill the new message type
         /*从一个外部的以来接口导入本地接口信息，测试失败*/
@@ -70,11 +77,17 @@ public:
     timer_ = this->create_wall_timer(1s, publish_msg);
   }
 
+  bool pool_enabled() const {return pool_.enabled;}
+
 private:
   // 声明发布者共享指针
-  rclcpp::Publisher<more_interfaces::msg::AddressBook>::SharedPtr address_book_publisher_;
+  rclcpp::Publisher<more_interfaces::msg::AddressBook, tutorial_utils::PoolAlloc>::SharedPtr
+    address_book_publisher_;
   // 声明定时器共享指针
   rclcpp::TimerBase::SharedPtr timer_;
+  // 内存池参数和计数打印定时器
+  tutorial_utils::PoolOptions pool_;
+  rclcpp::TimerBase::SharedPtr pool_stats_timer_;
 };
 
 // 主函数
@@ -82,8 +95,11 @@ int main(int argc, char * argv[])
 {
   // 初始化ROS2客户端库
   rclcpp::init(argc, argv);
+  tutorial_utils::startup_mark("init");
   // 创建AddressBookPublisher节点并进入自旋状态(处理回调)
-  rclcpp::spin(std::make_shared<AddressBookPublisher>());
+  auto node = std::make_shared<AddressBookPublisher>();
+  tutorial_utils::startup_mark("node");
+  tutorial_utils::spin(node, node->pool_enabled());
   // 关闭ROS2客户端库
   rclcpp::shutdown();
 
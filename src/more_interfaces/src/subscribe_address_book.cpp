@@ -1,5 +1,7 @@
 #include "rclcpp/rclcpp.hpp"
 #include "more_interfaces/msg/address_book.hpp"
+#include "tutorial_utils/pool_memory_strategy.hpp"
+#include "tutorial_utils/startup.hpp"
 
 class AddressBookSubscriber : public rclcpp::Node
 {
@@ -7,13 +9,21 @@ public:
     AddressBookSubscriber()
     : Node("address_book_subscriber")
     {
+        // pool allocator opt-in (memory.pool:=true)
+        pool_ = tutorial_utils::declare_pool_parameters(*this);
+        pool_stats_timer_ = tutorial_utils::enable_pool(*this, pool_);
+
         subscription_ = this->create_subscription<more_interfaces::msg::AddressBook>(
-            "address_book", 10, std::bind(&AddressBookSubscriber::topic_callback, this, std::placeholders::_1));
+            "address_book", 10, std::bind(&AddressBookSubscriber::topic_callback, this, std::placeholders::_1),
+            tutorial_utils::pool_subscription_options());
     }
 
+    bool pool_enabled() const { return pool_.enabled; }
+
 private:
     void topic_callback(const more_interfaces::msg::AddressBook::SharedPtr msg) const
     {
+        tutorial_utils::StartupProfiler::instance().finish("first_message", this->get_logger());
         RCLCPP_INFO(this->get_logger(), 
         "Received address book entry: first_name:%s, last_name:%s, phone_number: %s, phone_type: %d",
             msg->first_name.c_str(), 
@@ -22,13 +32,18 @@ private:
             msg->phone_type);
     }
 
-    rclcpp::Subscription<more_interfaces::msg::AddressBook>::SharedPtr subscription_;
+    rclcpp::Subscription<more_interfaces::msg::AddressBook, tutorial_utils::PoolAlloc>::SharedPtr subscription_;
+    rclcpp::TimerBase::SharedPtr pool_stats_timer_;
+    tutorial_utils::PoolOptions pool_;
 };
 
 int main(int argc, char * argv[])
 {
     rclcpp::init(argc, argv);
-    rclcpp::spin(std::make_shared<AddressBookSubscriber>());
+    tutorial_utils::startup_mark("init");
+    auto node = std::make_shared<AddressBookSubscriber>();
+    tutorial_utils::startup_mark("node");
+    tutorial_utils::spin(node, node->pool_enabled());
     rclcpp::shutdown();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,294 @@
+// transport_benchmark：比较 UDP 回环和共享内存传输下大消息的延迟、CPU 和拷贝次数。
+// 两个进程做 ping-pong：ping 发送 AddressBookBatch（或 Fibonacci 结果），pong 原样发回。
+// 传输方式由 FASTRTPS_DEFAULT_PROFILES_FILE 指定的配置决定（config/fastdds_udp.xml / fastdds_shm.xml），
+// 最方便的用法是 launch/transport_benchmark_launch.py transport:=udp|shm。
+//
+// 拷贝次数的估算：用户态序列化/反序列化固定 2 次；内核拷贝通过 /proc/net/dev 中 lo 网卡的
+// 字节数统计：UDP 每字节经过内核两次（发送和接收），共享内存时 lo 上只剩发现报文。
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/serialization.hpp"
+#include "more_interfaces/msg/address_book_batch.hpp"
+#include "action_tutorials_interfaces/action/fibonacci.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+using AddressBookBatch = more_interfaces::msg::AddressBookBatch;
+using FibonacciResult = action_tutorials_interfaces::action::Fibonacci::Result;
+
+// 进程 CPU 时间（用户态 + 内核态），单位秒
+double cpu_seconds()
+{
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// lo 网卡累计发送字节数，读取失败时返回 0
+uint64_t loopback_tx_bytes()
+{
+  std::ifstream dev("/proc/net/dev");
+  std::string line;
+  while (std::getline(dev, line)) {
+    auto colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    std::string name = line.substr(0, colon);
+    name.erase(0, name.find_first_not_of(' '));
+    if (name != "lo") {
+      continue;
+    }
+    std::istringstream fields(line.substr(colon + 1));
+    uint64_t value = 0;
+    for (int i = 0; i <= 8 && fields >> value; ++i) {
+      // 前 8 列是接收统计，第 9 列是发送字节数
+    }
+    return value;
+  }
+  return 0;
+}
+
+template<typename MessageT>
+size_t serialized_size(const MessageT & msg)
+{
+  rclcpp::Serialization<MessageT> serialization;
+  rclcpp::SerializedMessage serialized;
+  serialization.serialize_message(&msg, &serialized);
+  return serialized.size();
+}
+
+// 用固定的联系人填充通讯录，使序列化后约为 bytes 字节
+void fill_message(AddressBookBatch & msg, size_t bytes)
+{
+  more_interfaces::msg::AddressBook entry;
+  entry.first_name = "John";
+  entry.last_name = "Doe";
+  entry.phone_number = "1234567890";
+  entry.phone_type = entry.PHONE_TYPE_MOBILE;
+
+  msg.entries.assign(1, entry);
+  size_t one = serialized_size(msg);
+  msg.entries.assign(2, entry);
+  size_t per_entry = std::max<size_t>(serialized_size(msg) - one, 1);
+  msg.entries.assign(std::max<size_t>(bytes / per_entry, 1), entry);
+}
+
+void fill_message(FibonacciResult & msg, size_t bytes)
+{
+  msg.sequence.resize(std::max<size_t>(bytes / sizeof(int32_t), 1));
+  for (size_t i = 0; i < msg.sequence.size(); ++i) {
+    msg.sequence[i] = static_cast<int32_t>(i);
+  }
+}
+
+double percentile(std::vector<double> sorted, double p)
+{
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  std::sort(sorted.begin(), sorted.end());
+  auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+  return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+class Runner
+{
+public:
+  virtual ~Runner() = default;
+};
+
+template<typename MessageT>
+class PingRunner : public Runner
+{
+public:
+  PingRunner(rclcpp::Node * node, std::vector<int64_t> sizes, int iterations, int warmup)
+  : node_(node), sizes_(std::move(sizes)), iterations_(iterations), warmup_(warmup)
+  {
+    auto qos = rclcpp::QoS(1).reliable();
+    publisher_ = node_->create_publisher<MessageT>("bench_ping", qos);
+    subscription_ = node_->create_subscription<MessageT>(
+      "bench_pong", qos, [this](const typename MessageT::SharedPtr) {on_pong();});
+    // 等待 pong 端的订阅和发布都匹配后再开始
+    wait_timer_ = node_->create_wall_timer(100ms, [this]() {
+          if (publisher_->get_subscription_count() > 0 && subscription_->get_publisher_count() > 0) {
+            wait_timer_->cancel();
+            RCLCPP_INFO(
+              node_->get_logger(),
+              "size(B) serialized(B) iters rtt_p50(us) rtt_p99(us) rtt_max(us) one_way_p50(us) "
+              "ping_cpu(us/msg) lo_bytes/msg kernel_copies/msg");
+            begin_size();
+          }
+        });
+  }
+
+private:
+  void begin_size()
+  {
+    fill_message(message_, static_cast<size_t>(sizes_[index_]));
+    serialized_bytes_ = serialized_size(message_);
+    rtts_us_.clear();
+    sent_ = 0;
+    send();
+  }
+
+  void send()
+  {
+    if (sent_ == warmup_) {
+      // 预热结束，开始计量
+      cpu_start_ = cpu_seconds();
+      lo_start_ = loopback_tx_bytes();
+    }
+    t_send_ = Clock::now();
+    ++sent_;
+    publisher_->publish(message_);
+  }
+
+  void on_pong()
+  {
+    auto rtt = std::chrono::duration<double, std::micro>(Clock::now() - t_send_).count();
+    if (sent_ > warmup_) {
+      rtts_us_.push_back(rtt);
+    }
+    if (sent_ < warmup_ + iterations_) {
+      send();
+      return;
+    }
+    finish_size();
+  }
+
+  void finish_size()
+  {
+    double cpu_us = (cpu_seconds() - cpu_start_) * 1e6 / iterations_;
+    // 一次往返包含两条消息，lo 上的字节数按单条消息平均
+    double lo_bytes = static_cast<double>(loopback_tx_bytes() - lo_start_) / (2.0 * iterations_);
+    double kernel_copies = serialized_bytes_ > 0 ? 2.0 * lo_bytes / serialized_bytes_ : 0.0;
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1)
+       << sizes_[index_] << " " << serialized_bytes_ << " " << iterations_ << " "
+       << percentile(rtts_us_, 0.5) << " " << percentile(rtts_us_, 0.99) << " "
+       << percentile(rtts_us_, 1.0) << " " << percentile(rtts_us_, 0.5) / 2.0 << " "
+       << cpu_us << " " << lo_bytes << " " << std::setprecision(2) << 2.0 + kernel_copies
+       << " (2 user + " << kernel_copies << " kernel)";
+    RCLCPP_INFO(node_->get_logger(), "%s", ss.str().c_str());
+
+    if (++index_ < sizes_.size()) {
+      begin_size();
+    } else {
+      RCLCPP_INFO(node_->get_logger(), "Transport benchmark finished");
+      rclcpp::shutdown();
+    }
+  }
+
+  rclcpp::Node * node_;
+  std::vector<int64_t> sizes_;
+  int iterations_;
+  int warmup_;
+  typename rclcpp::Publisher<MessageT>::SharedPtr publisher_;
+  typename rclcpp::Subscription<MessageT>::SharedPtr subscription_;
+  rclcpp::TimerBase::SharedPtr wait_timer_;
+
+  MessageT message_;
+  size_t index_ = 0;
+  size_t serialized_bytes_ = 0;
+  int sent_ = 0;
+  Clock::time_point t_send_;
+  double cpu_start_ = 0.0;
+  uint64_t lo_start_ = 0;
+  std::vector<double> rtts_us_;
+};
+
+template<typename MessageT>
+class PongRunner : public Runner
+{
+public:
+  explicit PongRunner(rclcpp::Node * node)
+  : node_(node)
+  {
+    auto qos = rclcpp::QoS(1).reliable();
+    publisher_ = node_->create_publisher<MessageT>("bench_pong", qos);
+    subscription_ = node_->create_subscription<MessageT>(
+      "bench_ping", qos, [this](const typename MessageT::SharedPtr msg) {
+        ++received_;
+        publisher_->publish(*msg);
+      });
+  }
+
+  ~PongRunner() override
+  {
+    RCLCPP_INFO(
+      node_->get_logger(), "Pong echoed %lu messages, cpu(s): %.3f",
+      static_cast<unsigned long>(received_), cpu_seconds());
+  }
+
+private:
+  rclcpp::Node * node_;
+  typename rclcpp::Publisher<MessageT>::SharedPtr publisher_;
+  typename rclcpp::Subscription<MessageT>::SharedPtr subscription_;
+  uint64_t received_ = 0;
+};
+
+template<typename MessageT>
+std::unique_ptr<Runner> make_runner(
+  rclcpp::Node * node, const std::string & role,
+  const std::vector<int64_t> & sizes, int iterations, int warmup)
+{
+  if (role == "pong") {
+    return std::make_unique<PongRunner<MessageT>>(node);
+  }
+  return std::make_unique<PingRunner<MessageT>>(node, sizes, iterations, warmup);
+}
+
+}  // namespace
+
+class TransportBenchmark : public rclcpp::Node
+{
+public:
+  TransportBenchmark()
+  : Node("transport_benchmark")
+  {
+    auto role = this->declare_parameter<std::string>("role", "ping");           // ping | pong
+    auto payload = this->declare_parameter<std::string>("payload", "address_book");  // address_book | fibonacci
+    // 默认覆盖 1 KB 到 100 MB
+    auto sizes = this->declare_parameter<std::vector<int64_t>>(
+      "sizes", {1024, 16384, 262144, 1048576, 16777216, 104857600});
+    auto iterations = this->declare_parameter<int>("iterations", 20);
+    auto warmup = this->declare_parameter<int>("warmup", 3);
+
+    RCLCPP_INFO(this->get_logger(), "role=%s payload=%s", role.c_str(), payload.c_str());
+    if (payload == "fibonacci") {
+      runner_ = make_runner<FibonacciResult>(this, role, sizes, iterations, warmup);
+    } else {
+      runner_ = make_runner<AddressBookBatch>(this, role, sizes, iterations, warmup);
+    }
+  }
+
+private:
+  std::unique_ptr<Runner> runner_;
+};
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  rclcpp::spin(std::make_shared<TransportBenchmark>());
+  rclcpp::shutdown();
+  return 0;
+}
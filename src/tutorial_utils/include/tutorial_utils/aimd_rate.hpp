@@ -0,0 +1,109 @@
+#ifndef TUTORIAL_UTILS__AIMD_RATE_HPP_
+#define TUTORIAL_UTILS__AIMD_RATE_HPP_
+
+// Additive-increase / multiplicative-decrease publish rate control.
+//
+// The subscriber reports, once per feedback window, the worst age (receive time minus source
+// timestamp) of the messages it took off its queue and the fraction lost to sequence gaps.
+// Both are needed: with a keep-last queue the messages left in it are always the newest ones, so
+// a publisher far above the drain rate shows a bounded age and a high loss rate instead.
+// While both stay under target the publisher adds increase_hz to its rate; when either goes over,
+// the rate is multiplied by decrease_factor and the next `holdoff` reports are ignored, since
+// they still describe the backlog built up before the cut. Under overload the rate settles just
+// below what the subscriber can drain instead of overflowing its queue.
+//
+// The publisher keeps its fixed base timer and asks admit() on every tick, so no timer has to be
+// recreated when the rate changes:
+//
+//   tutorial_utils::AimdRateController rate(config);
+//   ... feedback callback:  rate.on_feedback(msg.max_age_ms, msg.loss_rate);
+//   ... 1 kHz timer:        if (!rate.admit(1000.0)) {return;}
+
+#include <algorithm>
+#include <cstdint>
+
+namespace tutorial_utils
+{
+
+struct AimdConfig
+{
+  double min_hz = 10.0;
+  double max_hz = 1000.0;
+  double target_age_ms = 5.0;
+  double max_loss_rate = 0.001;
+  double increase_hz = 20.0;      // per feedback window below target
+  double decrease_factor = 0.5;   // per feedback window above target
+  uint32_t holdoff = 1;           // windows ignored after a decrease
+};
+
+class AimdRateController
+{
+public:
+  enum class Action
+  {
+    Increase,
+    Decrease,
+    Hold,
+  };
+
+  explicit AimdRateController(const AimdConfig & config = AimdConfig())
+  : config_(sanitize(config)), rate_hz_(config_.max_hz)
+  {
+  }
+
+  Action on_feedback(double max_age_ms, double loss_rate = 0.0)
+  {
+    if (holdoff_left_ > 0) {
+      --holdoff_left_;
+      return Action::Hold;
+    }
+    if (max_age_ms > config_.target_age_ms || loss_rate > config_.max_loss_rate) {
+      rate_hz_ = std::max(config_.min_hz, rate_hz_ * config_.decrease_factor);
+      holdoff_left_ = config_.holdoff;
+      ++decreases_;
+      return Action::Decrease;
+    }
+    if (rate_hz_ >= config_.max_hz) {
+      return Action::Hold;
+    }
+    rate_hz_ = std::min(config_.max_hz, rate_hz_ + config_.increase_hz);
+    return Action::Increase;
+  }
+
+  // Called on every tick of a base timer running at tick_hz; true when this tick should publish.
+  bool admit(double tick_hz)
+  {
+    credit_ += rate_hz_ / tick_hz;
+    if (credit_ < 1.0) {
+      return false;
+    }
+    credit_ = std::min(credit_ - 1.0, 1.0);  // no bursts to catch up after a slow period
+    return true;
+  }
+
+  double rate_hz() const {return rate_hz_;}
+  uint64_t decreases() const {return decreases_;}
+  const AimdConfig & config() const {return config_;}
+
+private:
+  static AimdConfig sanitize(AimdConfig c)
+  {
+    c.max_hz = std::max(c.max_hz, 1e-3);
+    c.min_hz = std::min(std::max(c.min_hz, 1e-3), c.max_hz);
+    c.increase_hz = std::max(c.increase_hz, 0.0);
+    if (!(c.decrease_factor > 0.0 && c.decrease_factor < 1.0)) {
+      c.decrease_factor = 0.5;
+    }
+    return c;
+  }
+
+  AimdConfig config_;
+  double rate_hz_;
+  double credit_ = 0.0;
+  uint32_t holdoff_left_ = 0;
+  uint64_t decreases_ = 0;
+};
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__AIMD_RATE_HPP_
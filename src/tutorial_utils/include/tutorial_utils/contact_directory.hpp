@@ -0,0 +1,602 @@
+#ifndef TUTORIAL_UTILS__CONTACT_DIRECTORY_HPP_
+#define TUTORIAL_UTILS__CONTACT_DIRECTORY_HPP_
+
+// In-memory contact directory built incrementally from an address book stream
+// (more_interfaces contact_directory node), sized for millions of contacts.
+//
+//  - phone index: open addressing with linear probing over 8-byte slots (32-bit hash tag + record
+//    id), load factor <= 0.5. Full 64-bit phone hashes are kept in a column, so growing the table
+//    never touches the strings.
+//  - last-name index: sorted runs of (last_name, id) plus a small unsorted append buffer. A full
+//    buffer is sorted into a new run and runs of similar size are merged, so an insert costs
+//    amortised O(log n) moves and a prefix query is one equal_range per run.
+//  - phone_type: a one-byte column, counted 8 bytes at a time in parallel chunks on a small
+//    worker pool.
+//
+// Upserts are keyed by phone number. When an update changes the last name the old index entry is
+// marked dead in place; queries skip dead entries and merges drop them.
+// Thread safety: queries run concurrently with each other, upserts are exclusive.
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tutorial_utils
+{
+
+struct ContactRecord
+{
+  std::string first_name;
+  std::string last_name;
+  std::string phone_number;
+  uint8_t phone_type = 0;
+};
+
+// Deterministic synthetic contact number i (benchmarks and demos): unique 10-digit phone number for
+// i < 10^10, last names drawn from 24 x 24 syllable pairs so prefixes have realistic fan-out.
+inline ContactRecord synthetic_contact(uint64_t i)
+{
+  static const char * const syllables[] = {
+    "Ab", "Bel", "Car", "Dan", "El", "Fer", "Gar", "Hol", "Is", "Jan", "Kel", "Lor",
+    "Mar", "Nor", "Ol", "Par", "Quin", "Ros", "Sal", "Tor", "Ul", "Ver", "Wil", "Yor"};
+  uint64_t h = (i + 1) * 0x9e3779b97f4a7c15ull;
+  h ^= h >> 31;
+  ContactRecord record;
+  record.last_name = std::string(syllables[h % 24]) + syllables[(h >> 8) % 24] + "son";
+  record.first_name = std::string(syllables[(h >> 16) % 24]) + syllables[(h >> 24) % 24];
+  char phone[11];
+  uint64_t number = (i * 7919 + 12345) % 10000000000ull;  // 7919 is coprime to 10^10: no collisions
+  for (int d = 9; d >= 0; --d) {
+    phone[d] = static_cast<char>('0' + number % 10);
+    number /= 10;
+  }
+  phone[10] = '\0';
+  record.phone_number = phone;
+  record.phone_type = static_cast<uint8_t>((h >> 32) % 3);
+  return record;
+}
+
+// Fixed set of worker threads that run one chunked task at a time; the caller runs chunk 0.
+class ScanPool
+{
+public:
+  using Task = std::function<void(size_t chunk, size_t chunks)>;
+
+  explicit ScanPool(size_t threads)
+  {
+    for (size_t i = 1; i < std::max<size_t>(threads, 1); ++i) {
+      workers_.emplace_back([this, i]() {work(i);});
+    }
+  }
+
+  ~ScanPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+      ++generation_;
+    }
+    wake_.notify_all();
+    for (auto & worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ScanPool(const ScanPool &) = delete;
+  ScanPool & operator=(const ScanPool &) = delete;
+
+  size_t threads() const {return workers_.size() + 1;}
+
+  // Calls task(chunk, threads()) for every chunk and returns when all have finished.
+  void run(const Task & task)
+  {
+    if (workers_.empty()) {
+      task(0, 1);
+      return;
+    }
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      remaining_ = workers_.size();
+      ++generation_;
+    }
+    wake_.notify_all();
+    task(0, threads());
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() {return remaining_ == 0;});
+    task_ = nullptr;
+  }
+
+  // [begin, end) of chunk `chunk` when n items are split into `chunks` parts
+  static std::pair<size_t, size_t> split(size_t n, size_t chunk, size_t chunks)
+  {
+    return {n * chunk / chunks, n * (chunk + 1) / chunks};
+  }
+
+private:
+  void work(size_t chunk)
+  {
+    uint64_t seen = 0;
+    for (;;) {
+      const Task * task = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this, seen]() {return generation_ != seen;});
+        seen = generation_;
+        if (stop_) {
+          return;
+        }
+        task = task_;
+      }
+      (*task)(chunk, threads());
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--remaining_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const Task * task_ = nullptr;
+  size_t remaining_ = 0;
+  uint64_t generation_ = 0;
+  bool stop_ = false;
+};
+
+class ContactDirectory
+{
+public:
+  struct Options
+  {
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t buffer_size = 256;           // unsorted last-name entries before they become a run
+    size_t parallel_min = 1 << 18;      // smaller scans stay on the calling thread
+  };
+
+  struct QueryResult
+  {
+    std::vector<ContactRecord> contacts;  // at most max_results, in index order
+    uint64_t total = 0;                   // all matches, regardless of max_results
+  };
+
+  struct Stats
+  {
+    size_t contacts = 0;
+    size_t runs = 0;
+    size_t buffered = 0;
+    size_t stale = 0;
+    size_t hash_capacity = 0;
+  };
+
+  ContactDirectory()
+  : ContactDirectory(Options()) {}
+
+  explicit ContactDirectory(Options options)
+  : options_(options), pool_(options.threads), slots_(1024) {}
+
+  void reserve(size_t contacts)
+  {
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    records_.reserve(contacts);
+    hashes_.reserve(contacts);
+    types_.reserve(contacts);
+    size_t capacity = slots_.size();
+    while (capacity < contacts * 2) {
+      capacity *= 2;
+    }
+    if (capacity != slots_.size()) {
+      rehash(capacity);
+    }
+  }
+
+  // Inserts a new contact or updates the one with the same phone number; true when inserted.
+  bool upsert(ContactRecord record)
+  {
+    uint64_t hash = hash_phone(record.phone_number);
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    size_t slot = probe(record.phone_number, hash);
+    if (slots_[slot].id != 0) {
+      uint32_t id = slots_[slot].id - 1;
+      auto & current = records_[id];
+      types_[id] = record.phone_type;
+      if (current.last_name != record.last_name) {
+        kill_name(current.last_name, id);
+        add_name(record.last_name, id);
+      }
+      current = std::move(record);
+      // many renames: rebuild the index instead of carrying the dead entries around
+      if (stale_ * 8 > records_.size() + options_.buffer_size) {
+        rebuild_names();
+      }
+      return false;
+    }
+
+    auto id = static_cast<uint32_t>(records_.size());
+    slots_[slot] = Slot{static_cast<uint32_t>(hash >> 32), id + 1};
+    hashes_.push_back(hash);
+    types_.push_back(record.phone_type);
+    add_name(record.last_name, id);
+    records_.push_back(std::move(record));
+    if (records_.size() * 2 > slots_.size()) {
+      rehash(slots_.size() * 2);
+    }
+    return true;
+  }
+
+  size_t size() const
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    return records_.size();
+  }
+
+  bool find_phone(const std::string & phone_number, ContactRecord & out) const
+  {
+    uint64_t hash = hash_phone(phone_number);
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    const Slot & slot = slots_[probe(phone_number, hash)];
+    if (slot.id == 0) {
+      return false;
+    }
+    out = records_[slot.id - 1];
+    return true;
+  }
+
+  // Contacts whose last name starts with prefix, ordered by last name; max_results 0 = no limit.
+  QueryResult last_name_prefix(const std::string & prefix, size_t max_results) const
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto limit = max_results == 0 ? SIZE_MAX : max_results;
+    QueryResult result;
+    std::vector<const NameKey *> hits;
+    for (const auto & key : buffer_) {
+      if (!key.dead && key.last.compare(0, prefix.size(), prefix) == 0) {
+        ++result.total;
+        hits.push_back(&key);
+      }
+    }
+    for (const auto & run : runs_) {
+      auto first = std::lower_bound(run.keys.begin(), run.keys.end(), prefix, key_less);
+      auto last = prefix_end(run.keys, first, prefix);
+      auto lo = static_cast<size_t>(first - run.keys.begin());
+      auto hi = static_cast<size_t>(last - run.keys.begin());
+      result.total += (hi - lo) - run.dead_between(lo, hi);
+      // each run is sorted, so its first `limit` live entries are all a merged answer can use
+      size_t taken = 0;
+      for (auto key = first; key != last && taken < limit; ++key) {
+        if (!key->dead) {
+          hits.push_back(&*key);
+          ++taken;
+        }
+      }
+    }
+    std::sort(
+      hits.begin(), hits.end(), [](const NameKey * a, const NameKey * b) {return key_order(*a, *b);});
+    hits.resize(std::min(hits.size(), limit));
+    result.contacts.reserve(hits.size());
+    for (auto key : hits) {
+      result.contacts.push_back(records_[key->id]);
+    }
+    return result;
+  }
+
+  // Contacts with the given phone_type in insertion order; max_results 0 = no limit.
+  QueryResult phone_type(uint8_t type, size_t max_results) const
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto limit = max_results == 0 ? SIZE_MAX : max_results;
+    size_t n = types_.size();
+    size_t chunks = n >= options_.parallel_min ? pool_.threads() : 1;
+    std::vector<uint64_t> counts(chunks, 0);
+    std::vector<std::vector<uint32_t>> ids(chunks);
+    auto scan = [&](size_t chunk, size_t) {
+        auto range = ScanPool::split(n, chunk, chunks);
+        const uint8_t * column = types_.data();
+        auto & out = ids[chunk];
+        size_t i = range.first;
+        // collect ids until the limit, then only count
+        for (; i < range.second && out.size() < limit; ++i) {
+          if (column[i] == type) {
+            out.push_back(static_cast<uint32_t>(i));
+          }
+        }
+        counts[chunk] = out.size() + count_bytes(column + i, range.second - i, type);
+      };
+    if (chunks > 1) {
+      pool_.run(scan);
+    } else {
+      scan(0, 1);
+    }
+
+    QueryResult result;
+    for (size_t c = 0; c < chunks; ++c) {
+      result.total += counts[c];
+      for (auto id : ids[c]) {
+        if (result.contacts.size() >= limit) {
+          break;
+        }
+        result.contacts.push_back(records_[id]);
+      }
+    }
+    return result;
+  }
+
+  Stats stats() const
+  {
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    Stats stats;
+    stats.contacts = records_.size();
+    stats.runs = runs_.size();
+    stats.buffered = buffer_.size();
+    stats.stale = stale_;
+    stats.hash_capacity = slots_.size();
+    return stats;
+  }
+
+  size_t threads() const {return pool_.threads();}
+
+  // FNV-1a, 8 bytes at a time for the bulk of the string
+  static uint64_t hash_phone(const std::string & phone)
+  {
+    uint64_t h = 1469598103934665603ull;
+    size_t i = 0;
+    for (; i + 8 <= phone.size(); i += 8) {
+      uint64_t word = 0;
+      std::memcpy(&word, phone.data() + i, 8);
+      h = (h ^ word) * 1099511628211ull;
+    }
+    for (; i < phone.size(); ++i) {
+      h = (h ^ static_cast<unsigned char>(phone[i])) * 1099511628211ull;
+    }
+    return h ^ (h >> 29);
+  }
+
+  // number of bytes equal to value, 8 at a time (SWAR zero-byte count)
+  static size_t count_bytes(const uint8_t * data, size_t n, uint8_t value)
+  {
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+    const uint64_t pattern = ones * value;
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 8 <= n) {
+      // per-byte counters in one word, folded before any byte can reach 256
+      uint64_t lanes = 0;
+      size_t end = std::min(n - n % 8, i + 8 * 255);
+      for (; i < end; i += 8) {
+        uint64_t x;
+        std::memcpy(&x, data + i, 8);
+        x ^= pattern;  // matching bytes become zero
+        lanes += ~(((x & low7) + low7) | x | low7) >> 7;  // 1 in every zero byte
+      }
+      count += static_cast<size_t>((lanes & 0x00ff00ff00ff00ffull) * 0x0001000100010001ull >> 48);
+      count += static_cast<size_t>((lanes >> 8 & 0x00ff00ff00ff00ffull) * 0x0001000100010001ull >> 48);
+    }
+    for (; i < n; ++i) {
+      count += data[i] == value ? 1 : 0;
+    }
+    return count;
+  }
+
+private:
+  struct Slot
+  {
+    uint32_t tag = 0;
+    uint32_t id = 0;  // record id + 1, 0 = empty
+  };
+
+  struct NameKey
+  {
+    std::string last;
+    uint32_t id;
+    bool dead;  // the record's last name has changed since this entry was added
+  };
+
+  // Sorted last-name entries. Dead entries stay in place until the run is merged; a Fenwick tree
+  // over their positions (built on the first death) lets a prefix count subtract them in O(log n).
+  struct Run
+  {
+    std::vector<NameKey> keys;
+    std::vector<uint32_t> dead_tree;
+    size_t dead = 0;
+
+    void mark_dead(size_t pos)
+    {
+      keys[pos].dead = true;
+      ++dead;
+      if (dead_tree.empty()) {
+        dead_tree.assign(keys.size() + 1, 0);
+      }
+      for (size_t i = pos + 1; i < dead_tree.size(); i += i & (~i + 1)) {
+        ++dead_tree[i];
+      }
+    }
+
+    size_t dead_before(size_t pos) const
+    {
+      size_t sum = 0;
+      for (size_t i = pos; i > 0; i -= i & (~i + 1)) {
+        sum += dead_tree[i];
+      }
+      return sum;
+    }
+
+    size_t dead_between(size_t lo, size_t hi) const
+    {
+      return dead == 0 ? 0 : dead_before(hi) - dead_before(lo);
+    }
+  };
+
+  static bool key_order(const NameKey & a, const NameKey & b)
+  {
+    int c = a.last.compare(b.last);
+    return c < 0 || (c == 0 && a.id < b.id);
+  }
+  static bool key_less(const NameKey & a, const std::string & b) {return a.last < b;}
+
+  // first entry at or after `first` whose last name no longer starts with prefix
+  static std::vector<NameKey>::const_iterator prefix_end(
+    const std::vector<NameKey> & keys, std::vector<NameKey>::const_iterator first, const std::string & prefix)
+  {
+    // smallest string greater than every string with this prefix
+    std::string bound = prefix;
+    while (!bound.empty() && static_cast<unsigned char>(bound.back()) == 0xff) {
+      bound.pop_back();
+    }
+    if (bound.empty()) {
+      return keys.end();
+    }
+    bound.back() = static_cast<char>(static_cast<unsigned char>(bound.back()) + 1);
+    return std::lower_bound(first, keys.end(), bound, key_less);
+  }
+
+  size_t probe(const std::string & phone_number, uint64_t hash) const
+  {
+    size_t mask = slots_.size() - 1;
+    auto tag = static_cast<uint32_t>(hash >> 32);
+    for (size_t i = static_cast<size_t>(hash) & mask;; i = (i + 1) & mask) {
+      const Slot & slot = slots_[i];
+      if (slot.id == 0 ||
+        (slot.tag == tag && records_[slot.id - 1].phone_number == phone_number))
+      {
+        return i;
+      }
+    }
+  }
+
+  void rehash(size_t capacity)
+  {
+    std::vector<Slot> slots(capacity);
+    size_t mask = capacity - 1;
+    for (size_t id = 0; id < hashes_.size(); ++id) {
+      size_t i = static_cast<size_t>(hashes_[id]) & mask;
+      while (slots[i].id != 0) {
+        i = (i + 1) & mask;
+      }
+      slots[i] = Slot{static_cast<uint32_t>(hashes_[id] >> 32), static_cast<uint32_t>(id + 1)};
+    }
+    slots_.swap(slots);
+  }
+
+  // marks the live index entry (last, id) dead; there is exactly one
+  void kill_name(const std::string & last, uint32_t id)
+  {
+    ++stale_;
+    for (auto & key : buffer_) {
+      if (!key.dead && key.id == id && key.last == last) {
+        key.dead = true;
+        return;
+      }
+    }
+    NameKey probe_key{last, id, false};
+    for (auto & run : runs_) {
+      auto it = std::lower_bound(run.keys.begin(), run.keys.end(), probe_key, key_order);
+      // earlier renames back to this name may have left dead twins in front of the live entry
+      for (; it != run.keys.end() && it->id == id && it->last == last; ++it) {
+        if (!it->dead) {
+          run.mark_dead(static_cast<size_t>(it - run.keys.begin()));
+          return;
+        }
+      }
+    }
+  }
+
+  void add_name(const std::string & last, uint32_t id)
+  {
+    buffer_.push_back(NameKey{last, id, false});
+    if (buffer_.size() < options_.buffer_size) {
+      return;
+    }
+    std::sort(buffer_.begin(), buffer_.end(), key_order);
+    Run run;
+    run.keys = std::move(buffer_);
+    for (size_t pos = 0; pos < run.keys.size(); ++pos) {
+      if (run.keys[pos].dead) {
+        run.mark_dead(pos);
+      }
+    }
+    runs_.push_back(std::move(run));
+    buffer_.clear();
+    buffer_.reserve(options_.buffer_size);
+    // keep run sizes at least doubling towards the front: O(log n) runs
+    while (runs_.size() >= 2 && runs_[runs_.size() - 2].keys.size() <= 2 * runs_.back().keys.size()) {
+      auto & older = runs_[runs_.size() - 2].keys;
+      auto & newer = runs_.back().keys;
+      Run merged;
+      merged.keys.reserve(older.size() + newer.size());
+      auto a = older.begin();
+      auto b = newer.begin();
+      auto keep = [&](NameKey & key) {
+          if (key.dead) {
+            --stale_;
+          } else {
+            merged.keys.push_back(std::move(key));
+          }
+        };
+      while (a != older.end() && b != newer.end()) {
+        keep(key_order(*b, *a) ? *b++ : *a++);
+      }
+      for (; a != older.end(); ++a) {
+        keep(*a);
+      }
+      for (; b != newer.end(); ++b) {
+        keep(*b);
+      }
+      runs_.pop_back();
+      runs_.back() = std::move(merged);
+    }
+  }
+
+  void rebuild_names()
+  {
+    Run all;
+    all.keys.reserve(records_.size());
+    for (auto & run : runs_) {
+      for (auto & key : run.keys) {
+        if (!key.dead) {
+          all.keys.push_back(std::move(key));
+        }
+      }
+    }
+    for (auto & key : buffer_) {
+      if (!key.dead) {
+        all.keys.push_back(std::move(key));
+      }
+    }
+    std::sort(all.keys.begin(), all.keys.end(), key_order);
+    runs_.clear();
+    runs_.push_back(std::move(all));
+    buffer_.clear();
+    stale_ = 0;
+  }
+
+  Options options_;
+  mutable ScanPool pool_;
+  mutable std::shared_timed_mutex mutex_;
+
+  std::vector<ContactRecord> records_;
+  std::vector<uint64_t> hashes_;  // phone hash per record, for rehashing
+  std::vector<uint8_t> types_;    // phone_type column for parallel scans
+  std::vector<Slot> slots_;
+
+  std::vector<Run> runs_;          // largest first
+  std::vector<NameKey> buffer_;    // unsorted, at most buffer_size
+  size_t stale_ = 0;               // dead entries in runs_ and buffer_
+};
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__CONTACT_DIRECTORY_HPP_
@@ -0,0 +1,480 @@
+#ifndef TUTORIAL_UTILS__PERF_GATE_HPP_
+#define TUTORIAL_UTILS__PERF_GATE_HPP_
+
+// Performance regression gate for the test_perf gtests (ctest label "perf"). The packages register
+// them only when configured with -DPERF_GATE=ON, so the default test run does not depend on a
+// baseline recorded on this host. A benchmark is run as `repetitions` timed batches; its median and MAD (median
+// absolute deviation) per iteration are compared against a baseline JSON file kept in the package:
+//
+//   {
+//     "host": "<cpu model> | <n> cpus",
+//     "benchmarks": {
+//       "talker_build_in_place_128": {"median_ns": 31.2, "mad_ns": 0.4, "repetitions": 15}
+//     }
+//   }
+//
+// A result is a regression only when it is both significant and large enough to matter:
+//   z     = (median - base_median) / (1.4826 * sqrt(mad^2 + base_mad^2))  > z_threshold (4)
+//   ratio = median / base_median                                           > 1 + min_slowdown (10%)
+// Baselines are per host, keyed on the CPU rather than the machine name so that identical CI
+// runners share one. When the file was recorded on another host, or has no entry for a benchmark,
+// the check fails: an unrecorded baseline must not pass as "no regression".
+//
+// Environment:
+//   PERF_GATE_UPDATE=1    write this run's results to the baseline file instead of comparing
+//   PERF_GATE_DISABLE=1   run nothing (e.g. on shared, noisy CI machines, or hosts without a baseline)
+//   PERF_GATE_HOST=<id>   host id to record and compare under, instead of the CPU fingerprint
+//   PERF_GATE_Z, PERF_GATE_MIN_SLOWDOWN   override the thresholds
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tutorial_utils
+{
+
+struct PerfResult
+{
+  std::string name;
+  double median_ns = 0.0;   // per iteration
+  double mad_ns = 0.0;
+  size_t repetitions = 0;
+  uint64_t iterations = 0;  // per repetition
+};
+
+struct PerfOptions
+{
+  size_t repetitions = 15;
+  double min_repetition_ms = 5.0;  // iterations per repetition are calibrated to at least this
+  size_t warmup = 2;               // untimed repetitions before measuring
+};
+
+inline double median_of(std::vector<double> values)
+{
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  size_t mid = values.size() / 2;
+  return values.size() % 2 == 1 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+inline double mad_of(const std::vector<double> & values, double median)
+{
+  std::vector<double> deviations;
+  deviations.reserve(values.size());
+  for (auto v : values) {
+    deviations.push_back(std::fabs(v - median));
+  }
+  return median_of(std::move(deviations));
+}
+
+// body(n) runs the measured operation n times.
+template<typename Body>
+PerfResult run_benchmark(const std::string & name, Body && body, const PerfOptions & options = PerfOptions())
+{
+  using Clock = std::chrono::steady_clock;
+  auto timed = [&body](uint64_t n) {
+      auto start = Clock::now();
+      body(n);
+      return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+  // calibrate: double n until one batch takes min_repetition_ms
+  uint64_t n = 1;
+  while (n < (uint64_t{1} << 40)) {
+    if (timed(n) >= options.min_repetition_ms * 1e6) {
+      break;
+    }
+    n *= 2;
+  }
+  for (size_t i = 0; i < options.warmup; ++i) {
+    timed(n);
+  }
+  std::vector<double> per_iteration;
+  per_iteration.reserve(options.repetitions);
+  for (size_t i = 0; i < options.repetitions; ++i) {
+    per_iteration.push_back(timed(n) / static_cast<double>(n));
+  }
+
+  PerfResult result;
+  result.name = name;
+  result.median_ns = median_of(per_iteration);
+  result.mad_ns = mad_of(per_iteration, result.median_ns);
+  result.repetitions = options.repetitions;
+  result.iterations = n;
+  return result;
+}
+
+// "<cpu model> | <n> cpus", or PERF_GATE_HOST when set: baselines only compare on the host that
+// recorded them
+inline std::string host_fingerprint()
+{
+  const char * override_id = std::getenv("PERF_GATE_HOST");
+  if (override_id != nullptr && override_id[0] != '\0') {
+    return override_id;
+  }
+  std::string model = "unknown cpu";
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 10, "model name") == 0) {
+      auto colon = line.find(':');
+      if (colon != std::string::npos) {
+        model = line.substr(line.find_first_not_of(' ', colon + 1));
+      }
+      break;
+    }
+  }
+  return model + " | " + std::to_string(std::thread::hardware_concurrency()) + " cpus";
+}
+
+struct PerfBaselineEntry
+{
+  double median_ns = 0.0;
+  double mad_ns = 0.0;
+  size_t repetitions = 0;
+};
+
+// Reads and writes the baseline file. The reader accepts the subset of JSON the writer produces
+// (objects, strings, numbers), which keeps the gate free of extra dependencies.
+class PerfBaseline
+{
+public:
+  std::string host;
+  std::map<std::string, PerfBaselineEntry> benchmarks;
+
+  bool load(const std::string & path, std::string & error)
+  {
+    std::ifstream in(path);
+    if (!in) {
+      error = "cannot open " + path;
+      return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    text_ = buffer.str();
+    pos_ = 0;
+    host.clear();
+    benchmarks.clear();
+    if (!parse_root()) {
+      error = path + ": malformed baseline near offset " + std::to_string(pos_);
+      return false;
+    }
+    return true;
+  }
+
+  bool save(const std::string & path, std::string & error) const
+  {
+    std::ofstream out(path);
+    if (!out) {
+      error = "cannot write " + path;
+      return false;
+    }
+    out << "{\n  \"host\": \"" << escape(host) << "\",\n  \"benchmarks\": {";
+    size_t i = 0;
+    for (const auto & entry : benchmarks) {
+      char numbers[128];
+      std::snprintf(
+        numbers, sizeof(numbers), "{\"median_ns\": %.3f, \"mad_ns\": %.3f, \"repetitions\": %zu}",
+        entry.second.median_ns, entry.second.mad_ns, entry.second.repetitions);
+      out << (i++ == 0 ? "\n" : ",\n") << "    \"" << escape(entry.first) << "\": " << numbers;
+    }
+    out << "\n  }\n}\n";
+    return static_cast<bool>(out);
+  }
+
+private:
+  static std::string escape(const std::string & s)
+  {
+    std::string out;
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+      }
+      out += c;
+    }
+    return out;
+  }
+
+  void skip_space()
+  {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  bool expect(char c)
+  {
+    skip_space();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  bool peek(char c)
+  {
+    skip_space();
+    return pos_ < text_.size() && text_[pos_] == c;
+  }
+
+  bool parse_string(std::string & out)
+  {
+    if (!expect('"')) {
+      return false;
+    }
+    out.clear();
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) {
+        ++pos_;
+      }
+      out += text_[pos_++];
+    }
+    return expect('"');
+  }
+
+  bool parse_number(double & out)
+  {
+    skip_space();
+    const char * begin = text_.c_str() + pos_;
+    char * end = nullptr;
+    out = std::strtod(begin, &end);
+    if (end == begin) {
+      return false;
+    }
+    pos_ += static_cast<size_t>(end - begin);
+    return true;
+  }
+
+  // {"key": value, ...}; on_member(key) parses the value
+  template<typename OnMember>
+  bool parse_object(OnMember on_member)
+  {
+    if (!expect('{')) {
+      return false;
+    }
+    if (expect('}')) {
+      return true;
+    }
+    do {
+      std::string key;
+      if (!parse_string(key) || !expect(':') || !on_member(key)) {
+        return false;
+      }
+    } while (expect(','));
+    return expect('}');
+  }
+
+  bool skip_value()
+  {
+    if (peek('"')) {
+      std::string ignored;
+      return parse_string(ignored);
+    }
+    if (peek('{')) {
+      return parse_object([this](const std::string &) {return skip_value();});
+    }
+    double ignored = 0.0;
+    return parse_number(ignored);
+  }
+
+  bool parse_root()
+  {
+    return parse_object(
+      [this](const std::string & key) {
+        if (key == "host") {
+          return parse_string(host);
+        }
+        if (key == "benchmarks") {
+          return parse_object(
+            [this](const std::string & name) {
+              PerfBaselineEntry entry;
+              bool ok = parse_object(
+                [this, &entry](const std::string & field) {
+                  double value = 0.0;
+                  if (field != "median_ns" && field != "mad_ns" && field != "repetitions") {
+                    return skip_value();
+                  }
+                  if (!parse_number(value)) {
+                    return false;
+                  }
+                  if (field == "median_ns") {
+                    entry.median_ns = value;
+                  } else if (field == "mad_ns") {
+                    entry.mad_ns = value;
+                  } else {
+                    entry.repetitions = static_cast<size_t>(value);
+                  }
+                  return true;
+                });
+              benchmarks[name] = entry;
+              return ok;
+            });
+        }
+        return skip_value();
+      });
+  }
+
+  std::string text_;
+  size_t pos_ = 0;
+};
+
+struct PerfVerdict
+{
+  bool compared = false;    // false: no usable baseline, nothing to judge
+  bool regression = false;
+  bool missing_baseline = false;  // PerfGate: no baseline entry for this benchmark on this host
+  double ratio = 0.0;       // median / baseline median
+  double z = 0.0;
+  std::string message;
+
+  bool passed() const {return !regression && !missing_baseline;}
+};
+
+struct PerfThresholds
+{
+  double z = 4.0;
+  double min_slowdown = 0.10;
+};
+
+inline PerfVerdict compare_to_baseline(
+  const PerfBaselineEntry & base, const PerfResult & result, const PerfThresholds & thresholds)
+{
+  PerfVerdict verdict;
+  verdict.compared = base.median_ns > 0.0;
+  if (!verdict.compared) {
+    return verdict;
+  }
+  verdict.ratio = result.median_ns / base.median_ns;
+  // 1.4826 * MAD estimates the standard deviation of normally distributed samples; the floor keeps
+  // a zero-MAD baseline (very stable micro-benchmark) from making every nanosecond significant
+  double sigma = 1.4826 * std::sqrt(result.mad_ns * result.mad_ns + base.mad_ns * base.mad_ns);
+  sigma = std::max(sigma, 0.005 * base.median_ns);
+  verdict.z = (result.median_ns - base.median_ns) / sigma;
+  verdict.regression = verdict.z > thresholds.z && verdict.ratio > 1.0 + thresholds.min_slowdown;
+  char text[256];
+  std::snprintf(
+    text, sizeof(text), "%s: %.1f ns (mad %.1f) vs baseline %.1f ns (mad %.1f): x%.3f, z=%.1f%s",
+    result.name.c_str(), result.median_ns, result.mad_ns, base.median_ns, base.mad_ns, verdict.ratio,
+    verdict.z, verdict.regression ? "  REGRESSION" : "");
+  verdict.message = text;
+  return verdict;
+}
+
+// One per test binary: loads the baseline at construction, judges each result, and in update
+// mode writes all results back when destroyed.
+class PerfGate
+{
+public:
+  explicit PerfGate(std::string baseline_path)
+  : path_(std::move(baseline_path)), host_(host_fingerprint())
+  {
+    update_ = env_flag("PERF_GATE_UPDATE");
+    disabled_ = env_flag("PERF_GATE_DISABLE");
+    thresholds_.z = env_number("PERF_GATE_Z", thresholds_.z);
+    thresholds_.min_slowdown = env_number("PERF_GATE_MIN_SLOWDOWN", thresholds_.min_slowdown);
+    std::string error;
+    if (!baseline_.load(path_, error)) {
+      std::printf("perf_gate: %s\n", error.c_str());
+    }
+    same_host_ = baseline_.host == host_;
+    if (!update_ && !disabled_ && baseline_.host.empty()) {
+      std::printf(
+        "perf_gate: no baseline recorded in %s yet: every check fails "
+        "(PERF_GATE_UPDATE=1 records one on this host, PERF_GATE_DISABLE=1 skips the gate)\n",
+        path_.c_str());
+    } else if (!update_ && !disabled_ && !same_host_) {
+      std::printf(
+        "perf_gate: baseline recorded on '%s', this is '%s': every check fails "
+        "(PERF_GATE_UPDATE=1 re-baselines on this host, PERF_GATE_HOST=<id> selects a host id, "
+        "PERF_GATE_DISABLE=1 skips the gate)\n", baseline_.host.c_str(), host_.c_str());
+    }
+  }
+
+  ~PerfGate()
+  {
+    if (!update_ || recorded_.empty()) {
+      return;
+    }
+    // keep entries of benchmarks that did not run in this binary (e.g. filtered out)
+    PerfBaseline out;
+    out.host = host_;
+    if (same_host_) {
+      out.benchmarks = baseline_.benchmarks;
+    }
+    for (const auto & result : recorded_) {
+      out.benchmarks[result.name] = PerfBaselineEntry{result.median_ns, result.mad_ns, result.repetitions};
+    }
+    std::string error;
+    if (out.save(path_, error)) {
+      std::printf("perf_gate: wrote %zu benchmarks to %s\n", recorded_.size(), path_.c_str());
+    } else {
+      std::printf("perf_gate: %s\n", error.c_str());
+    }
+  }
+
+  PerfGate(const PerfGate &) = delete;
+  PerfGate & operator=(const PerfGate &) = delete;
+
+  bool disabled() const {return disabled_;}
+
+  PerfVerdict check(const PerfResult & result)
+  {
+    PerfVerdict verdict;
+    recorded_.push_back(result);
+    auto it = baseline_.benchmarks.find(result.name);
+    if (!update_ && same_host_ && it != baseline_.benchmarks.end()) {
+      verdict = compare_to_baseline(it->second, result, thresholds_);
+    } else {
+      verdict.missing_baseline = !update_;
+      char text[256];
+      std::snprintf(
+        text, sizeof(text), "%s: %.1f ns (mad %.1f), %s", result.name.c_str(), result.median_ns,
+        result.mad_ns, update_ ? "recorded" :
+        "NO BASELINE for this host (record with PERF_GATE_UPDATE=1 or skip with PERF_GATE_DISABLE=1)");
+      verdict.message = text;
+    }
+    std::printf("perf_gate: %s\n", verdict.message.c_str());
+    std::fflush(stdout);
+    return verdict;
+  }
+
+private:
+  static bool env_flag(const char * name)
+  {
+    const char * value = std::getenv(name);
+    return value != nullptr && value[0] != '\0' && std::string(value) != "0";
+  }
+
+  static double env_number(const char * name, double fallback)
+  {
+    const char * value = std::getenv(name);
+    return value != nullptr && value[0] != '\0' ? std::atof(value) : fallback;
+  }
+
+  std::string path_;
+  std::string host_;
+  PerfBaseline baseline_;
+  PerfThresholds thresholds_;
+  std::vector<PerfResult> recorded_;
+  bool update_ = false;
+  bool disabled_ = false;
+  bool same_host_ = false;
+};
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__PERF_GATE_HPP_
@@ -0,0 +1,243 @@
+#ifndef TUTORIAL_UTILS__POOL_ALLOCATOR_HPP_
+#define TUTORIAL_UTILS__POOL_ALLOCATOR_HPP_
+
+// Fixed-arena pool allocator for rclcpp publishers, subscriptions and memory strategies.
+// Blocks are carved from one preallocated arena into power-of-two size classes and recycled
+// through per-class free lists, so the executor and fixed-size intra-process messages reach a
+// steady state without touching the global heap (see pool_memory_strategy.hpp for what is not
+// covered).
+// Requests larger than the biggest class, made before reserve() or after the arena is
+// exhausted, fall back to ::operator new; the counters tell the two paths apart.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace tutorial_utils
+{
+
+class PoolResource
+{
+public:
+  static constexpr size_t kMinBlockShift = 4;   // 16 B
+  static constexpr size_t kMaxBlockShift = 16;  // 64 KB
+  static constexpr size_t kNumClasses = kMaxBlockShift - kMinBlockShift + 1;
+
+  struct Stats
+  {
+    uint64_t pool_allocations;
+    uint64_t pool_deallocations;
+    uint64_t fallback_allocations;
+    uint64_t fallback_deallocations;
+    size_t arena_bytes;
+    size_t arena_used;  // bytes carved from the arena so far (high-water mark)
+  };
+
+  PoolResource()
+  {
+    for (auto & head : free_lists_) {
+      head = nullptr;
+    }
+  }
+
+  explicit PoolResource(size_t arena_bytes)
+  : PoolResource()
+  {
+    reserve(arena_bytes);
+  }
+
+  ~PoolResource()
+  {
+    ::operator delete(arena_);
+  }
+
+  PoolResource(const PoolResource &) = delete;
+  PoolResource & operator=(const PoolResource &) = delete;
+
+  // Allocate and pre-fault the arena. Only the first call has an effect; call it before
+  // other threads start allocating (node constructor / main) since owns() reads the arena
+  // bounds without locking.
+  bool reserve(size_t arena_bytes)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (arena_ != nullptr || arena_bytes == 0) {
+      return false;
+    }
+    arena_ = static_cast<char *>(::operator new(arena_bytes));
+    std::memset(arena_, 0, arena_bytes);  // pre-fault the arena (and lock it under mlockall)
+    arena_bytes_ = arena_bytes;
+    return true;
+  }
+
+  bool reserved() const {return arena_ != nullptr;}
+
+  void * allocate(size_t bytes)
+  {
+    size_t cls = size_class(bytes);
+    if (cls < kNumClasses) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (free_lists_[cls] != nullptr) {
+        FreeBlock * block = free_lists_[cls];
+        free_lists_[cls] = block->next;
+        ++pool_allocations_;
+        return block;
+      }
+      size_t block_bytes = size_t(1) << (cls + kMinBlockShift);
+      if (arena_used_ + block_bytes <= arena_bytes_) {
+        void * block = arena_ + arena_used_;
+        arena_used_ += block_bytes;
+        ++pool_allocations_;
+        return block;
+      }
+    }
+    fallback_allocations_.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(bytes);
+  }
+
+  void deallocate(void * p, size_t bytes)
+  {
+    if (p == nullptr) {
+      return;
+    }
+    if (!owns(p)) {
+      fallback_deallocations_.fetch_add(1, std::memory_order_relaxed);
+      ::operator delete(p);
+      return;
+    }
+    size_t cls = size_class(bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto block = static_cast<FreeBlock *>(p);
+    block->next = free_lists_[cls];
+    free_lists_[cls] = block;
+    ++pool_deallocations_;
+  }
+
+  bool owns(const void * p) const
+  {
+    auto c = static_cast<const char *>(p);
+    return arena_ != nullptr && c >= arena_ && c < arena_ + arena_bytes_;
+  }
+
+  size_t arena_bytes() const {return arena_bytes_;}
+
+  Stats stats()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Stats{
+      pool_allocations_, pool_deallocations_,
+      fallback_allocations_.load(std::memory_order_relaxed),
+      fallback_deallocations_.load(std::memory_order_relaxed),
+      arena_bytes_, arena_used_};
+  }
+
+  // Returns kNumClasses when the request is too large for the pool.
+  static size_t size_class(size_t bytes)
+  {
+    size_t cls = 0;
+    size_t block = size_t(1) << kMinBlockShift;
+    while (block < bytes && cls < kNumClasses) {
+      block <<= 1;
+      ++cls;
+    }
+    return cls;
+  }
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock * next;
+  };
+
+  std::mutex mutex_;
+  char * arena_ = nullptr;
+  size_t arena_bytes_ = 0;
+  size_t arena_used_ = 0;
+  FreeBlock * free_lists_[kNumClasses];
+  uint64_t pool_allocations_ = 0;    // guarded by mutex_
+  uint64_t pool_deallocations_ = 0;  // guarded by mutex_
+  std::atomic<uint64_t> fallback_allocations_{0};
+  std::atomic<uint64_t> fallback_deallocations_{0};
+};
+
+// Process-wide pool used by PoolAllocator. It starts without an arena, so nodes that do not
+// opt in pay nothing and every allocation is a (counted) fallback to the global heap.
+inline PoolResource & default_pool()
+{
+  static PoolResource pool;
+  return pool;
+}
+
+// Stateless std-compatible allocator over default_pool(), usable as the Alloc template
+// argument of rclcpp::PublisherOptionsWithAllocator / SubscriptionOptionsWithAllocator and
+// rclcpp::memory_strategies::allocator_memory_strategy::AllocatorMemoryStrategy.
+template<typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = PoolAllocator<U>;
+  };
+
+  PoolAllocator() noexcept = default;
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+  T * allocate(size_t n)
+  {
+    return static_cast<T *>(default_pool().allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T * p, size_t n)
+  {
+    default_pool().deallocate(p, n * sizeof(T));
+  }
+};
+
+// PoolAllocator<void> cannot allocate, but rclcpp passes it around and rebinds it.
+template<>
+class PoolAllocator<void>
+{
+public:
+  using value_type = void;
+  using pointer = void *;
+  using const_pointer = const void *;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = PoolAllocator<U>;
+  };
+
+  PoolAllocator() noexcept = default;
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U> &) noexcept {}
+};
+
+template<typename T, typename U>
+constexpr bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &) noexcept
+{
+  return true;
+}
+
+template<typename T, typename U>
+constexpr bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &) noexcept
+{
+  return false;
+}
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__POOL_ALLOCATOR_HPP_
@@ -0,0 +1,113 @@
+#ifndef TUTORIAL_UTILS__POOL_MEMORY_STRATEGY_HPP_
+#define TUTORIAL_UTILS__POOL_MEMORY_STRATEGY_HPP_
+
+// Plumbing to run a node on the pool allocator:
+//  - PoolPublisherOptions / PoolSubscriptionOptions for create_publisher / create_subscription,
+//  - PoolMemoryStrategy for the executor (wait-set bookkeeping),
+//  - memory.* parameters to opt in and to log the pool counters periodically.
+//
+// Zero global-heap allocations in steady state hold for the executor and for fixed-size
+// messages over intra-process only (test_pool_allocator). Message fields (std::string,
+// sequences) are still built with std::allocator by the generated type support, and the
+// middleware allocates for itself, so the inter-process std_msgs::String path of talker/listener
+// and the address book only gets its message objects and executor bookkeeping from the pool.
+
+#include <chrono>
+#include <memory>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/strategies/allocator_memory_strategy.hpp"
+#include "tutorial_utils/pool_allocator.hpp"
+
+namespace tutorial_utils
+{
+
+using PoolAlloc = PoolAllocator<void>;
+using PoolMemoryStrategy =
+  rclcpp::memory_strategies::allocator_memory_strategy::AllocatorMemoryStrategy<PoolAlloc>;
+using PoolPublisherOptions = rclcpp::PublisherOptionsWithAllocator<PoolAlloc>;
+using PoolSubscriptionOptions = rclcpp::SubscriptionOptionsWithAllocator<PoolAlloc>;
+
+struct PoolOptions
+{
+  bool enabled = false;
+  size_t arena_bytes = 16 * 1024 * 1024;
+  int stats_period_ms = 0;  // 0 disables the periodic counter log
+};
+
+// Declare the memory.* parameters on a node and return their values.
+inline PoolOptions declare_pool_parameters(rclcpp::Node & node)
+{
+  PoolOptions options;
+  options.enabled = node.declare_parameter<bool>("memory.pool", false);
+  options.arena_bytes = static_cast<size_t>(
+    node.declare_parameter<int>("memory.pool_mb", 16)) * 1024 * 1024;
+  options.stats_period_ms = node.declare_parameter<int>("memory.stats_period_ms", 0);
+  return options;
+}
+
+inline void log_pool_stats(const rclcpp::Logger & logger)
+{
+  auto stats = default_pool().stats();
+  RCLCPP_INFO(
+    logger, "pool: alloc=%lu free=%lu fallback_alloc=%lu fallback_free=%lu arena=%zu/%zu bytes",
+    static_cast<unsigned long>(stats.pool_allocations),
+    static_cast<unsigned long>(stats.pool_deallocations),
+    static_cast<unsigned long>(stats.fallback_allocations),
+    static_cast<unsigned long>(stats.fallback_deallocations),
+    stats.arena_used, stats.arena_bytes);
+}
+
+// Reserve the arena when the node opted in and start the counter log if requested.
+// Keep the returned timer alive for as long as the log should run.
+inline rclcpp::TimerBase::SharedPtr enable_pool(rclcpp::Node & node, const PoolOptions & options)
+{
+  if (!options.enabled) {
+    return nullptr;
+  }
+  default_pool().reserve(options.arena_bytes);
+  if (options.stats_period_ms <= 0) {
+    return nullptr;
+  }
+  auto logger = node.get_logger();
+  return node.create_wall_timer(
+    std::chrono::milliseconds(options.stats_period_ms),
+    [logger]() {log_pool_stats(logger);});
+}
+
+inline PoolPublisherOptions pool_publisher_options()
+{
+  PoolPublisherOptions options;
+  options.allocator = std::make_shared<PoolAlloc>();
+  return options;
+}
+
+inline PoolSubscriptionOptions pool_subscription_options()
+{
+  PoolSubscriptionOptions options;
+  options.allocator = std::make_shared<PoolAlloc>();
+  return options;
+}
+
+inline rclcpp::ExecutorOptions pool_executor_options()
+{
+  rclcpp::ExecutorOptions options;
+  options.memory_strategy = std::make_shared<PoolMemoryStrategy>(std::make_shared<PoolAlloc>());
+  return options;
+}
+
+// rclcpp::spin() replacement: with use_pool the executor's memory strategy draws from the pool.
+inline void spin(rclcpp::Node::SharedPtr node, bool use_pool)
+{
+  if (!use_pool) {
+    rclcpp::spin(node);
+    return;
+  }
+  rclcpp::executors::SingleThreadedExecutor executor(pool_executor_options());
+  executor.add_node(node);
+  executor.spin();
+}
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__POOL_MEMORY_STRATEGY_HPP_
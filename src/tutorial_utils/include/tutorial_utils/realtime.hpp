@@ -0,0 +1,155 @@
+#ifndef TUTORIAL_UTILS__REALTIME_HPP_
+#define TUTORIAL_UTILS__REALTIME_HPP_
+
+// Real-time startup helpers for the 1 kHz publishers.
+// Every step degrades gracefully: when the process lacks CAP_IPC_LOCK / CAP_SYS_NICE
+// (e.g. an unprivileged shell) the step is skipped with a warning and the node keeps running.
+
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace tutorial_utils
+{
+
+struct RealtimeOptions
+{
+  bool enabled = false;
+  bool lock_memory = true;
+  size_t prefault_heap_bytes = 64 * 1024 * 1024;
+  size_t prefault_stack_bytes = 512 * 1024;
+  int priority = 0;       // SCHED_FIFO priority, 0 keeps SCHED_OTHER
+  int cpu_affinity = -1;  // pin the calling thread to this CPU, -1 leaves it unpinned
+};
+
+// Declare the realtime.* parameters on a node and return their values.
+inline RealtimeOptions declare_realtime_parameters(rclcpp::Node & node)
+{
+  RealtimeOptions options;
+  options.enabled = node.declare_parameter<bool>("realtime.enabled", false);
+  options.lock_memory = node.declare_parameter<bool>("realtime.lock_memory", true);
+  options.prefault_heap_bytes = static_cast<size_t>(
+    node.declare_parameter<int>("realtime.prefault_heap_mb", 64)) * 1024 * 1024;
+  options.prefault_stack_bytes = static_cast<size_t>(
+    node.declare_parameter<int>("realtime.prefault_stack_kb", 512)) * 1024;
+  options.priority = node.declare_parameter<int>("realtime.priority", 0);
+  options.cpu_affinity = node.declare_parameter<int>("realtime.cpu_affinity", -1);
+  return options;
+}
+
+// Lock current and future pages in RAM so they are never paged out.
+inline bool lock_memory(std::string & error)
+{
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    error = std::string("mlockall failed: ") + std::strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+// Keep freed memory inside the heap, so memory touched once at startup is never
+// returned to the kernel and page-faulted in again later.
+inline void keep_heap_resident()
+{
+  mallopt(M_TRIM_THRESHOLD, -1);  // never trim the top of the heap
+  mallopt(M_MMAP_MAX, 0);         // serve large blocks from the heap, not mmap
+}
+
+// Touch every page of a large heap block once; with trimming disabled the pages stay
+// mapped after free(), so later allocations no longer page-fault.
+inline void prefault_heap(size_t bytes)
+{
+  if (bytes == 0) {
+    return;
+  }
+  auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto buffer = static_cast<volatile char *>(std::malloc(bytes));
+  if (buffer == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < bytes; i += page) {
+    buffer[i] = 0;
+  }
+  std::free(const_cast<char *>(buffer));
+}
+
+// Grow the stack of the calling thread to its worst-case depth once.
+inline void prefault_stack(size_t bytes)
+{
+  if (bytes == 0) {
+    return;
+  }
+  auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto stack = static_cast<volatile char *>(alloca(bytes));
+  for (size_t i = 0; i < bytes; i += page) {
+    stack[i] = 0;
+  }
+}
+
+inline bool set_fifo_priority(int priority, std::string & error)
+{
+  sched_param param{};
+  param.sched_priority = priority;
+  int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  if (ret != 0) {
+    error = std::string("SCHED_FIFO priority ") + std::to_string(priority) +
+      " failed: " + std::strerror(ret);
+    return false;
+  }
+  return true;
+}
+
+inline bool set_cpu_affinity(int cpu, std::string & error)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (ret != 0) {
+    error = std::string("CPU affinity ") + std::to_string(cpu) + " failed: " + std::strerror(ret);
+    return false;
+  }
+  return true;
+}
+
+// Apply the options to the process and the calling thread (the one that will spin).
+// Returns true when every requested step succeeded; failures are logged and skipped.
+inline bool apply_realtime(const RealtimeOptions & options, const rclcpp::Logger & logger)
+{
+  bool all_ok = true;
+  std::string error;
+  if (options.lock_memory && !lock_memory(error)) {
+    RCLCPP_WARN(logger, "%s, continuing without locked memory", error.c_str());
+    all_ok = false;
+  }
+  keep_heap_resident();
+  prefault_heap(options.prefault_heap_bytes);
+  prefault_stack(options.prefault_stack_bytes);
+  if (options.cpu_affinity >= 0 && !set_cpu_affinity(options.cpu_affinity, error)) {
+    RCLCPP_WARN(logger, "%s", error.c_str());
+    all_ok = false;
+  }
+  if (options.priority > 0 && !set_fifo_priority(options.priority, error)) {
+    RCLCPP_WARN(logger, "%s, staying on SCHED_OTHER", error.c_str());
+    all_ok = false;
+  }
+  RCLCPP_INFO(
+    logger, "Real-time mode: mlock=%d prefault_heap=%zuMB priority=%d cpu=%d (%s)",
+    options.lock_memory, options.prefault_heap_bytes / (1024 * 1024), options.priority,
+    options.cpu_affinity, all_ok ? "all settings applied" : "degraded");
+  return all_ok;
+}
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__REALTIME_HPP_
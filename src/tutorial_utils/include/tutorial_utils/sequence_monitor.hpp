@@ -0,0 +1,140 @@
+#ifndef TUTORIAL_UTILS__SEQUENCE_MONITOR_HPP_
+#define TUTORIAL_UTILS__SEQUENCE_MONITOR_HPP_
+
+// Subscriber-side sequence monitoring: one SequenceTracker per publisher GID, closed every
+// sequence.window_ms and published as diagnostic_msgs/DiagnosticArray on "diagnostics"
+// (one DiagnosticStatus per publisher of the monitored topic).
+//
+//   monitor_ = std::make_unique<tutorial_utils::SequenceMonitor>(*this, "chatter");
+//   ... in a callback taking (msg, const rclcpp::MessageInfo & info):
+//   monitor_->on_message(info, seq);
+//
+// on_window() registers a callback run for every publisher when its window closes, for
+// consumers that need the per-window loss rate (e.g. rate feedback to the publisher).
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "tutorial_utils/sequence_tracker.hpp"
+
+namespace tutorial_utils
+{
+
+class SequenceMonitor
+{
+public:
+  using Gid = std::array<uint8_t, RMW_GID_STORAGE_SIZE>;
+  using WindowCallback = std::function<void(const Gid & publisher, double window_loss_rate)>;
+
+  // Declares sequence.window_ms (default 1000) on the node.
+  SequenceMonitor(rclcpp::Node & node, const std::string & topic)
+  : node_name_(node.get_name()), topic_(topic), logger_(node.get_logger()), clock_(node.get_clock())
+  {
+    auto window_ms = node.declare_parameter<int>("sequence.window_ms", 1000);
+    diagnostics_pub_ = node.create_publisher<diagnostic_msgs::msg::DiagnosticArray>("diagnostics", 10);
+    timer_ = node.create_wall_timer(
+      std::chrono::milliseconds(window_ms > 0 ? window_ms : 1000), [this]() {close_window();});
+  }
+
+  SequenceTracker::Result on_message(const rclcpp::MessageInfo & info, uint64_t seq)
+  {
+    Gid gid;
+    std::memcpy(gid.data(), info.get_rmw_message_info().publisher_gid.data, gid.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trackers_[gid].on_message(seq);
+  }
+
+  // Called from the window timer, with the monitor's lock held.
+  void on_window(WindowCallback callback) {window_callback_ = std::move(callback);}
+
+private:
+  void close_window()
+  {
+    diagnostic_msgs::msg::DiagnosticArray array;
+    array.header.stamp = clock_->now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto & entry : trackers_) {
+      auto & tracker = entry.second;
+      double loss = tracker.close_window();
+      const auto & c = tracker.counters();
+
+      diagnostic_msgs::msg::DiagnosticStatus status;
+      status.name = node_name_ + ": " + topic_ + " sequence";
+      status.hardware_id = gid_hex(entry.first);
+      status.level = loss > 0.0 ? diagnostic_msgs::msg::DiagnosticStatus::WARN :
+        diagnostic_msgs::msg::DiagnosticStatus::OK;
+      status.message = loss > 0.0 ? "loss in last window" : "ok";
+      add(status, "received", std::to_string(c.received));
+      add(status, "lost", std::to_string(c.lost));
+      add(status, "reordered", std::to_string(c.reordered));
+      add(status, "duplicates", std::to_string(c.duplicates));
+      add(status, "resets", std::to_string(c.resets));
+      add(status, "highest_seq", std::to_string(c.highest));
+      add(status, "window_loss_rate", std::to_string(loss));
+      const auto & histogram = tracker.histogram();
+      static const char * const kBucketNames[SequenceTracker::kNumBuckets] = {
+        "windows_loss_0", "windows_loss_le_0.1pct", "windows_loss_le_1pct",
+        "windows_loss_le_5pct", "windows_loss_le_20pct", "windows_loss_gt_20pct"};
+      for (size_t i = 0; i < histogram.size(); ++i) {
+        add(status, kBucketNames[i], std::to_string(histogram[i]));
+      }
+      if (loss > 0.0) {
+        RCLCPP_WARN(
+          logger_, "%s from %s: %.3f%% loss in last window (lost=%lu reordered=%lu duplicates=%lu)",
+          topic_.c_str(), status.hardware_id.c_str(), loss * 100.0,
+          static_cast<unsigned long>(c.lost), static_cast<unsigned long>(c.reordered),
+          static_cast<unsigned long>(c.duplicates));
+      }
+      array.status.push_back(std::move(status));
+      if (window_callback_) {
+        window_callback_(entry.first, loss);
+      }
+    }
+    diagnostics_pub_->publish(array);
+  }
+
+  static void add(
+    diagnostic_msgs::msg::DiagnosticStatus & status, const char * key, const std::string & value)
+  {
+    diagnostic_msgs::msg::KeyValue kv;
+    kv.key = key;
+    kv.value = value;
+    status.values.push_back(std::move(kv));
+  }
+
+  // Fast DDS GIDs are a 12-byte guid prefix plus a 4-byte entity id; the rest is zero padding
+  static std::string gid_hex(const Gid & gid)
+  {
+    std::string out;
+    char byte[3];
+    for (size_t i = 0; i < 16 && i < gid.size(); ++i) {
+      std::snprintf(byte, sizeof(byte), "%02x", gid[i]);
+      out += byte;
+    }
+    return out;
+  }
+
+  std::string node_name_;
+  std::string topic_;
+  rclcpp::Logger logger_;
+  rclcpp::Clock::SharedPtr clock_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_pub_;
+  rclcpp::TimerBase::SharedPtr timer_;
+  std::mutex mutex_;
+  std::map<Gid, SequenceTracker> trackers_;
+  WindowCallback window_callback_;
+};
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__SEQUENCE_MONITOR_HPP_
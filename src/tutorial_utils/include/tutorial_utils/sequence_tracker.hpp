@@ -0,0 +1,146 @@
+#ifndef TUTORIAL_UTILS__SEQUENCE_TRACKER_HPP_
+#define TUTORIAL_UTILS__SEQUENCE_TRACKER_HPP_
+
+// Per-publisher sequence number bookkeeping for a subscriber: detects gaps (loss), late
+// arrivals (reordering, which also cancel the loss they were counted as) and duplicates,
+// and keeps a histogram of the loss rate per closed time window.
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace tutorial_utils
+{
+
+class SequenceTracker
+{
+public:
+  // Late messages are recognised within this many sequence numbers of the newest one;
+  // anything older is treated as a publisher restart.
+  static constexpr size_t kReorderWindow = 1024;
+
+  // Loss-rate histogram bucket upper bounds (fraction of expected messages per window);
+  // the last bucket collects everything above the final bound.
+  static constexpr size_t kNumBuckets = 6;
+  static double bucket_bound(size_t i)
+  {
+    static const double bounds[kNumBuckets - 1] = {0.0, 0.001, 0.01, 0.05, 0.2};
+    return bounds[i];
+  }
+
+  enum class Result
+  {
+    First,      // first message from this publisher
+    InOrder,
+    Gap,        // newer than expected, the skipped numbers are counted as lost
+    Reordered,  // older than the newest but not seen before
+    Duplicate,
+    Reset,      // far behind the newest: publisher restarted, tracking starts over
+  };
+
+  struct Counters
+  {
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t reordered = 0;
+    uint64_t duplicates = 0;
+    uint64_t resets = 0;
+    uint64_t highest = 0;
+  };
+
+  Result on_message(uint64_t seq)
+  {
+    ++counters_.received;
+    ++window_received_;
+    if (!started_) {
+      start(seq);
+      return Result::First;
+    }
+    if (seq > counters_.highest) {
+      uint64_t advance = seq - counters_.highest;
+      uint64_t gap = advance - 1;
+      counters_.lost += gap;
+      window_lost_ += static_cast<int64_t>(gap);
+      seen_ = advance >= kReorderWindow ? Window() : (seen_ << static_cast<size_t>(advance));
+      seen_.set(0);
+      counters_.highest = seq;
+      return gap == 0 ? Result::InOrder : Result::Gap;
+    }
+    uint64_t offset = counters_.highest - seq;
+    if (offset >= kReorderWindow) {
+      ++counters_.resets;
+      start(seq);
+      return Result::Reset;
+    }
+    if (seen_.test(static_cast<size_t>(offset))) {
+      ++counters_.duplicates;
+      --counters_.received;
+      --window_received_;
+      return Result::Duplicate;
+    }
+    seen_.set(static_cast<size_t>(offset));
+    ++counters_.reordered;
+    // numbers below the first one tracked (joined mid-stream, or after a reset) were never
+    // counted as lost, so there is no loss to cancel
+    if (seq > start_seq_) {
+      --counters_.lost;
+      --window_lost_;
+    }
+    return Result::Reordered;
+  }
+
+  // Close the current time window: record its loss rate in the histogram and return it.
+  double close_window()
+  {
+    int64_t lost = window_lost_ > 0 ? window_lost_ : 0;
+    uint64_t expected = window_received_ + static_cast<uint64_t>(lost);
+    double rate = expected > 0 ? static_cast<double>(lost) / static_cast<double>(expected) : 0.0;
+    if (expected > 0) {
+      ++histogram_[bucket(rate)];
+    }
+    last_window_loss_rate_ = rate;
+    window_received_ = 0;
+    window_lost_ = 0;
+    return rate;
+  }
+
+  static size_t bucket(double loss_rate)
+  {
+    for (size_t i = 0; i + 1 < kNumBuckets; ++i) {
+      if (loss_rate <= bucket_bound(i)) {
+        return i;
+      }
+    }
+    return kNumBuckets - 1;
+  }
+
+  const Counters & counters() const {return counters_;}
+  const std::array<uint64_t, kNumBuckets> & histogram() const {return histogram_;}
+  double last_window_loss_rate() const {return last_window_loss_rate_;}
+
+private:
+  using Window = std::bitset<kReorderWindow>;
+
+  void start(uint64_t seq)
+  {
+    started_ = true;
+    counters_.highest = seq;
+    start_seq_ = seq;
+    seen_.reset();
+    seen_.set(0);
+  }
+
+  bool started_ = false;
+  Counters counters_;
+  uint64_t start_seq_ = 0;  // first number after start or the last reset
+  Window seen_;  // bit i: highest - i has been received
+  uint64_t window_received_ = 0;
+  int64_t window_lost_ = 0;  // may dip below zero when a late message fills an older window's gap
+  double last_window_loss_rate_ = 0.0;
+  std::array<uint64_t, kNumBuckets> histogram_{};
+};
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__SEQUENCE_TRACKER_HPP_
@@ -0,0 +1,218 @@
+#ifndef TUTORIAL_UTILS__STARTUP_HPP_
+#define TUTORIAL_UTILS__STARTUP_HPP_
+
+// Startup-phase instrumentation and fast bring-up helpers.
+//
+// StartupProfiler timestamps named phases relative to the kernel's process start time (so
+// dynamic loading and static init are included) and prints them in one line when the first
+// unit of real work completes:
+//
+//   startup: talker init=41.2ms node=58.0ms first_publish=59.3ms
+//
+// Phases are always recorded (a few hundred bytes, once); the line is logged at INFO when
+// TUTORIAL_STARTUP_PROFILE is set to anything but "0", at DEBUG otherwise.
+//
+// wait_for_service / wait_for_action_server block on the node's graph event until the server
+// appears or the overall timeout expires, instead of the tutorial `while (!wait_for_service(1s))`
+// loops that log once per second.
+
+#include <errno.h>  // program_invocation_short_name
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace tutorial_utils
+{
+
+class StartupProfiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static StartupProfiler & instance()
+  {
+    static StartupProfiler profiler;
+    return profiler;
+  }
+
+  // Record a phase; only the first mark of each name is kept.
+  void mark(const char * phase)
+  {
+    if (reported_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    double ms = elapsed_ms();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto & p : phases_) {
+      if (p.first == phase) {
+        return;
+      }
+    }
+    phases_.emplace_back(phase, ms);
+  }
+
+  // Record the terminal phase (first message, first response, ...) and log all phases once.
+  // Cheap after the first call, so it can sit on a hot path.
+  void finish(const char * phase, const rclcpp::Logger & logger)
+  {
+    if (reported_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    mark(phase);
+    std::string line;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (reported_.exchange(true)) {
+        return;
+      }
+      line = "startup: " + name_;
+      char buf[64];
+      for (const auto & p : phases_) {
+        std::snprintf(buf, sizeof(buf), " %s=%.1fms", p.first.c_str(), p.second);
+        line += buf;
+      }
+    }
+    if (enabled_) {
+      RCLCPP_INFO(logger, "%s", line.c_str());
+    } else {
+      RCLCPP_DEBUG(logger, "%s", line.c_str());
+    }
+  }
+
+  // Milliseconds since the process was started by the kernel.
+  double elapsed_ms() const
+  {
+    return std::chrono::duration<double, std::milli>(Clock::now() - process_start_).count();
+  }
+
+private:
+  StartupProfiler()
+  {
+    const char * env = std::getenv("TUTORIAL_STARTUP_PROFILE");
+    enabled_ = env != nullptr && env[0] != '\0' && std::strcmp(env, "0") != 0;
+    name_ = program_invocation_short_name;
+    process_start_ = Clock::now() - since_process_start();
+  }
+
+  // /proc/self/stat field 22 is the start time in clock ticks after boot (10 ms resolution
+  // with the usual USER_HZ of 100); compare it against CLOCK_BOOTTIME now.
+  static Clock::duration since_process_start()
+  {
+    FILE * f = std::fopen("/proc/self/stat", "r");
+    if (f == nullptr) {
+      return Clock::duration::zero();
+    }
+    char buf[1024];
+    size_t n = std::fread(buf, 1, sizeof(buf) - 1, f);
+    std::fclose(f);
+    buf[n] = '\0';
+    // the command name (field 2) may contain spaces; fields after it start past the last ')'
+    const char * p = std::strrchr(buf, ')');
+    if (p == nullptr) {
+      return Clock::duration::zero();
+    }
+    unsigned long long start_ticks = 0;
+    int field = 2;
+    for (const char * tok = p + 1; *tok != '\0' && field < 22; ++tok) {
+      if (*tok == ' ') {
+        ++field;
+        if (field == 22) {
+          start_ticks = std::strtoull(tok + 1, nullptr, 10);
+        }
+      }
+    }
+    timespec boot{};
+    if (start_ticks == 0 || clock_gettime(CLOCK_BOOTTIME, &boot) != 0) {
+      return Clock::duration::zero();
+    }
+    double now_s = static_cast<double>(boot.tv_sec) + static_cast<double>(boot.tv_nsec) * 1e-9;
+    double start_s = static_cast<double>(start_ticks) / static_cast<double>(sysconf(_SC_CLK_TCK));
+    if (now_s < start_s) {
+      return Clock::duration::zero();
+    }
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(now_s - start_s));
+  }
+
+  bool enabled_ = false;
+  std::string name_;
+  Clock::time_point process_start_;
+  std::atomic<bool> reported_{false};
+  std::mutex mutex_;
+  std::vector<std::pair<std::string, double>> phases_;
+};
+
+// Shorthand for StartupProfiler::instance().mark(phase).
+inline void startup_mark(const char * phase)
+{
+  StartupProfiler::instance().mark(phase);
+}
+
+// Block until `is_ready()` holds, waking on the node's graph event rather than polling.
+// Returns false on timeout or shutdown.
+template<typename ReadyT>
+bool wait_for_graph(rclcpp::Node & node, ReadyT is_ready, std::chrono::nanoseconds timeout)
+{
+  auto event = node.get_graph_event();
+  if (is_ready()) {
+    return true;
+  }
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (rclcpp::ok()) {
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (remaining <= std::chrono::nanoseconds::zero()) {
+      return false;
+    }
+    // wakes on any graph change (or after 100 ms so shutdown is noticed)
+    node.wait_for_graph_change(
+      event, std::min<std::chrono::nanoseconds>(remaining, std::chrono::milliseconds(100)));
+    event->check_and_clear();
+    if (is_ready()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template<typename ClientT>
+bool wait_for_service(
+  rclcpp::Node & node, ClientT & client,
+  std::chrono::nanoseconds timeout = std::chrono::seconds(30))
+{
+  bool ready = wait_for_graph(node, [&client]() {return client.service_is_ready();}, timeout);
+  if (!ready && rclcpp::ok()) {
+    RCLCPP_ERROR(
+      node.get_logger(), "service '%s' not available after %.1f s", client.get_service_name(),
+      std::chrono::duration<double>(timeout).count());
+  }
+  return ready;
+}
+
+template<typename ActionClientT>
+bool wait_for_action_server(
+  rclcpp::Node & node, ActionClientT & client,
+  std::chrono::nanoseconds timeout = std::chrono::seconds(30))
+{
+  bool ready = wait_for_graph(node, [&client]() {return client.action_server_is_ready();}, timeout);
+  if (!ready && rclcpp::ok()) {
+    RCLCPP_ERROR(
+      node.get_logger(), "action server not available after %.1f s",
+      std::chrono::duration<double>(timeout).count());
+  }
+  return ready;
+}
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__STARTUP_HPP_
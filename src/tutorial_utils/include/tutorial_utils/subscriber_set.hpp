@@ -0,0 +1,311 @@
+#ifndef TUTORIAL_UTILS__SUBSCRIBER_SET_HPP_
+#define TUTORIAL_UTILS__SUBSCRIBER_SET_HPP_
+
+// Compile-time subscriber set: one subscription per (message type, topic, handler) entry. The
+// handlers are stored by value in a std::tuple and called directly from the lambda registered
+// with rclcpp, so there is no std::bind and no std::function of our own per handler.
+//
+//   set_ = tutorial_utils::make_subscriber_set(
+//     *this, rclcpp::QoS(10),
+//     tutorial_utils::on<std_msgs::msg::String>("chatter", [this](const std_msgs::msg::String & msg) {...}),
+//     tutorial_utils::on<tutorial_interfaces::msg::Num>(
+//       "topic", [this](const tutorial_interfaces::msg::Num & msg, const rclcpp::MessageInfo & info) {...}));
+//
+// Handler signatures, picked per entry at compile time:
+//   void(const T &)                                 message by reference, no refcount in the handler
+//   void(const T &, const rclcpp::MessageInfo &)
+//   void(std::unique_ptr<T>)                        ownership; no copy on the intra-process path
+//
+// Two ways to drive a set:
+//  - executor: spin the node as usual. rclcpp (Foxy) keeps one std::function per subscription and
+//    passes the message shared_ptr by value, so one refcount pair per message stays at that boundary.
+//  - take_all(): keep the node out of any executor, wait on a rclcpp::WaitSet filled by add_to() and
+//    call take_all(). Messages are taken into one preallocated message per entry and handed to the
+//    handler directly: no type erasure, no shared_ptr, no per-message allocation for const T& handlers.
+//
+// A set's type depends on its handler types; a member can hold it as
+// std::unique_ptr<SubscriberSetBase>, whose virtual calls are per wake-up, not per message.
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace tutorial_utils
+{
+
+enum class HandlerKind
+{
+  Ref,
+  RefWithInfo,
+  Unique,
+  Invalid
+};
+
+namespace detail
+{
+
+template<typename ...>
+struct make_void {using type = void;};
+template<typename ... Ts>
+using void_t = typename make_void<Ts...>::type;
+
+template<typename H, typename T, typename = void>
+struct takes_ref : std::false_type {};
+template<typename H, typename T>
+struct takes_ref<H, T, void_t<decltype(std::declval<H &>()(std::declval<const T &>()))>>
+  : std::true_type {};
+
+template<typename H, typename T, typename = void>
+struct takes_ref_with_info : std::false_type {};
+template<typename H, typename T>
+struct takes_ref_with_info<H, T, void_t<decltype(std::declval<H &>()(
+    std::declval<const T &>(), std::declval<const rclcpp::MessageInfo &>()))>>
+  : std::true_type {};
+
+template<typename H, typename T, typename = void>
+struct takes_unique : std::false_type {};
+template<typename H, typename T>
+struct takes_unique<H, T, void_t<decltype(std::declval<H &>()(std::declval<std::unique_ptr<T>>()))>>
+  : std::true_type {};
+
+template<HandlerKind K>
+using kind_tag = std::integral_constant<HandlerKind, K>;
+
+// take_all() target for unique_ptr handlers: they take into a fresh message they then own
+struct NoScratch {};
+
+}  // namespace detail
+
+// The cheapest form a handler accepts; RefWithInfo wins over Ref, Ref over Unique.
+template<typename HandlerT, typename MessageT>
+struct handler_kind
+  : detail::kind_tag<
+    detail::takes_ref_with_info<HandlerT, MessageT>::value ? HandlerKind::RefWithInfo :
+    detail::takes_ref<HandlerT, MessageT>::value ? HandlerKind::Ref :
+    detail::takes_unique<HandlerT, MessageT>::value ? HandlerKind::Unique : HandlerKind::Invalid>
+{};
+
+template<typename MessageT, typename HandlerT>
+struct SubscriberEntry
+{
+  using Message = MessageT;
+  using Kind = handler_kind<HandlerT, MessageT>;
+  static_assert(
+    Kind::value != HandlerKind::Invalid,
+    "handler must be callable as h(const T &), h(const T &, const rclcpp::MessageInfo &) "
+    "or h(std::unique_ptr<T>)");
+
+  std::string topic;
+  HandlerT handler;
+};
+
+template<typename MessageT, typename HandlerT>
+SubscriberEntry<MessageT, std::decay_t<HandlerT>> on(std::string topic, HandlerT && handler)
+{
+  return {std::move(topic), std::forward<HandlerT>(handler)};
+}
+
+class SubscriberSetBase
+{
+public:
+  virtual ~SubscriberSetBase() = default;
+  virtual void add_to(rclcpp::WaitSet & wait_set) = 0;
+  virtual size_t take_all() = 0;
+};
+
+template<typename ... Entries>
+class SubscriberSet : public SubscriberSetBase
+{
+  template<typename T, typename ... Es>
+  struct index_of : std::integral_constant<size_t, 0> {};
+  template<typename T, typename E, typename ... Es>
+  struct index_of<T, E, Es...>
+    : std::integral_constant<size_t,
+      std::is_same<T, typename E::Message>::value ? 0 : 1 + index_of<T, Es...>::value> {};
+
+  template<typename E>
+  struct scratch_of
+  {
+    using type = std::conditional_t<
+      E::Kind::value == HandlerKind::Unique, detail::NoScratch, typename E::Message>;
+  };
+
+public:
+  template<size_t I>
+  using entry_t = std::tuple_element_t<I, std::tuple<Entries...>>;
+  template<size_t I>
+  using message_t = typename entry_t<I>::Message;
+  // What take_all() deserializes entry I into between calls (reused), NoScratch for unique_ptr handlers.
+  template<size_t I>
+  using scratch_t = typename scratch_of<entry_t<I>>::type;
+
+  // Subscriptions capture pointers to the handlers, so a set never moves.
+  SubscriberSet(rclcpp::Node & node, const rclcpp::QoS & qos, Entries ... entries)
+  : entries_(std::move(entries)...)
+  {
+    subscribe_all(node, qos, std::index_sequence_for<Entries...>{});
+  }
+  SubscriberSet(const SubscriberSet &) = delete;
+  SubscriberSet & operator=(const SubscriberSet &) = delete;
+
+  static constexpr size_t size() {return sizeof...(Entries);}
+
+  template<size_t I>
+  const std::shared_ptr<rclcpp::Subscription<message_t<I>>> & subscription() const
+  {
+    return std::get<I>(subscriptions_);
+  }
+
+  // Calls entry I's handler exactly as a received message would.
+  template<size_t I>
+  void dispatch(const message_t<I> & msg, const rclcpp::MessageInfo & info = rclcpp::MessageInfo())
+  {
+    auto & entry = std::get<I>(entries_);
+    invoke(entry, msg, info, typename entry_t<I>::Kind());
+  }
+
+  // Same, routed by message type to the first entry of that type.
+  template<typename MessageT>
+  void dispatch(const MessageT & msg, const rclcpp::MessageInfo & info = rclcpp::MessageInfo())
+  {
+    constexpr size_t index = index_of<MessageT, Entries...>::value;
+    static_assert(index < sizeof...(Entries), "no entry for this message type");
+    dispatch<index>(msg, info);
+  }
+
+  void add_to(rclcpp::WaitSet & wait_set) override
+  {
+    add_all(wait_set, std::index_sequence_for<Entries...>{});
+  }
+
+  // Takes every pending message of every entry and returns how many were handled.
+  // Only for a node that is not spun by an executor.
+  size_t take_all() override
+  {
+    return take_each(std::index_sequence_for<Entries...>{});
+  }
+
+private:
+  using RefTag = detail::kind_tag<HandlerKind::Ref>;
+  using RefWithInfoTag = detail::kind_tag<HandlerKind::RefWithInfo>;
+  using UniqueTag = detail::kind_tag<HandlerKind::Unique>;
+
+  template<typename Entry>
+  static void invoke(Entry & entry, const typename Entry::Message & msg, const rclcpp::MessageInfo &, RefTag)
+  {
+    entry.handler(msg);
+  }
+  template<typename Entry>
+  static void invoke(
+    Entry & entry, const typename Entry::Message & msg, const rclcpp::MessageInfo & info, RefWithInfoTag)
+  {
+    entry.handler(msg, info);
+  }
+  template<typename Entry>
+  static void invoke(Entry & entry, const typename Entry::Message & msg, const rclcpp::MessageInfo &, UniqueTag)
+  {
+    entry.handler(std::make_unique<typename Entry::Message>(msg));
+  }
+
+  template<typename Entry>
+  static std::shared_ptr<rclcpp::Subscription<typename Entry::Message>> subscribe(
+    rclcpp::Node & node, const rclcpp::QoS & qos, Entry & entry, RefTag)
+  {
+    using T = typename Entry::Message;
+    auto & handler = entry.handler;
+    return node.create_subscription<T>(
+      entry.topic, qos, [&handler](std::shared_ptr<const T> msg) {handler(*msg);});
+  }
+  template<typename Entry>
+  static std::shared_ptr<rclcpp::Subscription<typename Entry::Message>> subscribe(
+    rclcpp::Node & node, const rclcpp::QoS & qos, Entry & entry, RefWithInfoTag)
+  {
+    using T = typename Entry::Message;
+    auto & handler = entry.handler;
+    return node.create_subscription<T>(
+      entry.topic, qos,
+      [&handler](std::shared_ptr<const T> msg, const rclcpp::MessageInfo & info) {handler(*msg, info);});
+  }
+  template<typename Entry>
+  static std::shared_ptr<rclcpp::Subscription<typename Entry::Message>> subscribe(
+    rclcpp::Node & node, const rclcpp::QoS & qos, Entry & entry, UniqueTag)
+  {
+    using T = typename Entry::Message;
+    auto & handler = entry.handler;
+    return node.create_subscription<T>(
+      entry.topic, qos, [&handler](std::unique_ptr<T> msg) {handler(std::move(msg));});
+  }
+
+  template<size_t ... I>
+  void subscribe_all(rclcpp::Node & node, const rclcpp::QoS & qos, std::index_sequence<I...>)
+  {
+    subscriptions_ = std::make_tuple(
+      subscribe(node, qos, std::get<I>(entries_), typename entry_t<I>::Kind())...);
+  }
+
+  template<size_t ... I>
+  void add_all(rclcpp::WaitSet & wait_set, std::index_sequence<I...>)
+  {
+    using expand = int[];
+    (void)expand{0, (wait_set.add_subscription(std::get<I>(subscriptions_)), 0)...};
+  }
+
+  template<size_t ... I>
+  size_t take_each(std::index_sequence<I...>)
+  {
+    size_t taken = 0;
+    using expand = int[];
+    // exact tags: Kind derives from kind_tag, so passing it would prefer the generic take_from
+    (void)expand{0, (taken += take_from<I>(detail::kind_tag<entry_t<I>::Kind::value>{}), 0)...};
+    return taken;
+  }
+
+  template<size_t I, typename Tag>
+  size_t take_from(Tag tag)
+  {
+    auto & entry = std::get<I>(entries_);
+    auto & scratch = std::get<I>(scratch_);
+    rclcpp::MessageInfo info;
+    size_t taken = 0;
+    while (std::get<I>(subscriptions_)->take(scratch, info)) {
+      invoke(entry, scratch, info, tag);
+      ++taken;
+    }
+    return taken;
+  }
+  template<size_t I>
+  size_t take_from(UniqueTag)
+  {
+    auto & entry = std::get<I>(entries_);
+    rclcpp::MessageInfo info;
+    size_t taken = 0;
+    auto owned = std::make_unique<message_t<I>>();
+    while (std::get<I>(subscriptions_)->take(*owned, info)) {
+      entry.handler(std::move(owned));
+      owned = std::make_unique<message_t<I>>();
+      ++taken;
+    }
+    return taken;
+  }
+
+  std::tuple<Entries...> entries_;
+  std::tuple<std::shared_ptr<rclcpp::Subscription<typename Entries::Message>>...> subscriptions_;
+  std::tuple<typename scratch_of<Entries>::type...> scratch_;  // take_all() target, reused across calls
+};
+
+template<typename ... Entries>
+std::unique_ptr<SubscriberSet<std::decay_t<Entries>...>> make_subscriber_set(
+  rclcpp::Node & node, const rclcpp::QoS & qos, Entries && ... entries)
+{
+  return std::make_unique<SubscriberSet<std::decay_t<Entries>...>>(
+    node, qos, std::forward<Entries>(entries)...);
+}
+
+}  // namespace tutorial_utils
+
+#endif  // TUTORIAL_UTILS__SUBSCRIBER_SET_HPP_
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+
+#include "tutorial_utils/aimd_rate.hpp"
+
+using tutorial_utils::AimdConfig;
+using tutorial_utils::AimdRateController;
+using Action = AimdRateController::Action;
+
+namespace
+{
+
+// Publisher on a 1 kHz timer, subscriber throttled to drain_hz behind a keep-last queue of
+// `depth` messages (what a depth-10 QoS does when the callback is too slow). The subscriber
+// reports the worst age it saw and the fraction of messages lost every window_ms.
+struct QueueModel
+{
+  explicit QueueModel(double drain)
+  : drain_hz(drain) {}
+
+  double drain_hz;
+  size_t depth = 10;
+  int window_ms = 100;
+
+  struct Totals
+  {
+    uint64_t published = 0;
+    uint64_t dropped = 0;
+    uint64_t received = 0;
+    double max_age_ms = 0.0;
+  };
+
+  // Runs `ms` milliseconds; `rate` may be null for a fixed 1 kHz publisher.
+  Totals run(AimdRateController * rate, int ms)
+  {
+    Totals totals;
+    for (int t = 0; t < ms; ++t, ++now_ms_) {
+      if (rate == nullptr || rate->admit(1000.0)) {
+        ++totals.published;
+        ++window_published_;
+        if (queue_.size() >= depth) {
+          queue_.pop_front();
+          ++totals.dropped;
+          ++window_dropped_;
+        }
+        queue_.push_back(now_ms_);
+      }
+      drain_credit_ += drain_hz / 1000.0;
+      while (drain_credit_ >= 1.0 && !queue_.empty()) {
+        drain_credit_ -= 1.0;
+        double age = static_cast<double>(now_ms_ - queue_.front());
+        queue_.pop_front();
+        ++totals.received;
+        window_max_age_ = std::max(window_max_age_, age);
+        totals.max_age_ms = std::max(totals.max_age_ms, age);
+      }
+      drain_credit_ = std::min(drain_credit_, 1.0);
+      if ((now_ms_ + 1) % window_ms == 0) {
+        if (rate != nullptr) {
+          double loss = window_published_ > 0 ?
+            static_cast<double>(window_dropped_) / static_cast<double>(window_published_) : 0.0;
+          rate->on_feedback(window_max_age_, loss);
+        }
+        window_max_age_ = 0.0;
+        window_published_ = 0;
+        window_dropped_ = 0;
+      }
+    }
+    return totals;
+  }
+
+  int64_t now_ms_ = 0;
+  double drain_credit_ = 0.0;
+  double window_max_age_ = 0.0;
+  uint64_t window_published_ = 0;
+  uint64_t window_dropped_ = 0;
+  std::deque<int64_t> queue_;
+};
+
+}  // namespace
+
+TEST(AimdRate, increase_decrease_holdoff)
+{
+  AimdConfig config;
+  config.min_hz = 10.0;
+  config.max_hz = 100.0;
+  config.increase_hz = 10.0;
+  config.target_age_ms = 5.0;
+  AimdRateController rate(config);
+  EXPECT_DOUBLE_EQ(100.0, rate.rate_hz());
+  EXPECT_EQ(Action::Hold, rate.on_feedback(1.0));  // already at max
+  EXPECT_EQ(Action::Decrease, rate.on_feedback(6.0));
+  EXPECT_DOUBLE_EQ(50.0, rate.rate_hz());
+  EXPECT_EQ(Action::Hold, rate.on_feedback(20.0));  // holdoff window
+  EXPECT_EQ(Action::Increase, rate.on_feedback(1.0));
+  EXPECT_DOUBLE_EQ(60.0, rate.rate_hz());
+  EXPECT_EQ(Action::Decrease, rate.on_feedback(1.0, 0.05));  // loss alone also cuts the rate
+  EXPECT_DOUBLE_EQ(30.0, rate.rate_hz());
+  rate.on_feedback(1.0);
+  for (int i = 0; i < 10; ++i) {
+    rate.on_feedback(100.0);
+  }
+  EXPECT_DOUBLE_EQ(10.0, rate.rate_hz());  // clamped to min_hz
+}
+
+TEST(AimdRate, admit_follows_rate)
+{
+  AimdConfig config;
+  config.max_hz = 250.0;
+  AimdRateController rate(config);
+  int admitted = 0;
+  for (int i = 0; i < 1000; ++i) {
+    admitted += rate.admit(1000.0) ? 1 : 0;
+  }
+  EXPECT_EQ(250, admitted);
+}
+
+TEST(AimdRate, fixed_rate_overflows_throttled_listener)
+{
+  QueueModel model{300.0};
+  auto totals = model.run(nullptr, 10000);
+  // the baseline this controller is meant to fix: most messages are dropped, while the age of
+  // what does arrive stays bounded by depth / publish rate and hides the overload
+  EXPECT_GT(totals.dropped, totals.published / 2);
+  EXPECT_LE(totals.max_age_ms, 10.0);
+}
+
+TEST(AimdRate, converges_below_throttled_listener)
+{
+  AimdConfig config;
+  config.target_age_ms = 10.0;
+  config.increase_hz = 10.0;
+  AimdRateController rate(config);
+  QueueModel model{300.0};
+
+  model.run(&rate, 5000);  // converge
+  auto totals = model.run(&rate, 20000);
+
+  double published_hz = static_cast<double>(totals.published) / 20.0;
+  EXPECT_GT(published_hz, 0.5 * model.drain_hz);
+  EXPECT_LE(published_hz, 1.05 * model.drain_hz);
+  EXPECT_LT(static_cast<double>(totals.dropped), 0.01 * static_cast<double>(totals.published));
+  EXPECT_LE(totals.max_age_ms, 3.0 * config.target_age_ms);
+  EXPECT_GT(rate.decreases(), 0u);
+}
+
+TEST(AimdRate, recovers_when_listener_speeds_up)
+{
+  AimdConfig config;
+  config.target_age_ms = 10.0;
+  config.increase_hz = 20.0;
+  AimdRateController rate(config);
+  QueueModel model{200.0};
+  model.run(&rate, 10000);
+  EXPECT_LT(rate.rate_hz(), 400.0);
+
+  model.drain_hz = 5000.0;  // listener no longer throttled
+  model.run(&rate, 10000);
+  EXPECT_DOUBLE_EQ(config.max_hz, rate.rate_hz());
+}
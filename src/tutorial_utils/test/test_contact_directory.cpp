@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tutorial_utils/contact_directory.hpp"
+
+using tutorial_utils::ContactDirectory;
+using tutorial_utils::ContactRecord;
+
+namespace
+{
+
+ContactRecord contact(const std::string & last, const std::string & phone, uint8_t type)
+{
+  ContactRecord record;
+  record.first_name = "F" + phone;
+  record.last_name = last;
+  record.phone_number = phone;
+  record.phone_type = type;
+  return record;
+}
+
+// small buffer and parallel threshold so a few thousand contacts exercise runs, merges and the pool
+ContactDirectory::Options small_options()
+{
+  ContactDirectory::Options options;
+  options.threads = 4;
+  options.buffer_size = 16;
+  options.parallel_min = 64;
+  return options;
+}
+
+// Reference model: phone -> record, checked against the directory after random upserts.
+struct Model
+{
+  std::map<std::string, ContactRecord> by_phone;
+
+  std::vector<std::string> prefix(const std::string & p) const
+  {
+    std::vector<std::pair<std::string, std::string>> hits;  // (last, phone)
+    for (const auto & entry : by_phone) {
+      if (entry.second.last_name.compare(0, p.size(), p) == 0) {
+        hits.emplace_back(entry.second.last_name, entry.first);
+      }
+    }
+    std::sort(hits.begin(), hits.end());
+    std::vector<std::string> lasts;
+    for (const auto & hit : hits) {
+      lasts.push_back(hit.first);
+    }
+    return lasts;
+  }
+};
+
+}  // namespace
+
+TEST(ContactDirectory, upsert_and_find_by_phone)
+{
+  ContactDirectory directory(small_options());
+  EXPECT_TRUE(directory.upsert(contact("Doe", "1234567890", 2)));
+  EXPECT_TRUE(directory.upsert(contact("Roe", "4254242424", 0)));
+  EXPECT_FALSE(directory.upsert(contact("Doe", "1234567890", 1)));
+  EXPECT_EQ(2u, directory.size());
+
+  ContactRecord found;
+  ASSERT_TRUE(directory.find_phone("1234567890", found));
+  EXPECT_EQ("Doe", found.last_name);
+  EXPECT_EQ(1, found.phone_type);
+  EXPECT_FALSE(directory.find_phone("0000000000", found));
+}
+
+TEST(ContactDirectory, hash_index_survives_growth)
+{
+  ContactDirectory directory(small_options());
+  for (int i = 0; i < 20000; ++i) {
+    directory.upsert(contact("L", std::to_string(1000000 + i), 0));
+  }
+  EXPECT_EQ(20000u, directory.size());
+  EXPECT_GE(directory.stats().hash_capacity, 40000u);
+  ContactRecord found;
+  for (int i = 0; i < 20000; i += 997) {
+    ASSERT_TRUE(directory.find_phone(std::to_string(1000000 + i), found));
+    EXPECT_EQ(std::to_string(1000000 + i), found.phone_number);
+  }
+}
+
+TEST(ContactDirectory, prefix_and_phone_type_match_reference_with_renames)
+{
+  ContactDirectory directory(small_options());
+  Model model;
+  std::mt19937 rng(42);
+  const char * stems[] = {"Smith", "Smyth", "Doe", "Dorsey", "Brown", "Browning", "Li", "Lin", "Lindqvist"};
+  for (int i = 0; i < 5000; ++i) {
+    // ~20% of upserts hit an existing phone, often with a different last name
+    auto phone = std::to_string(5550000 + static_cast<int>(rng() % 4000));
+    auto last = std::string(stems[rng() % 9]) + static_cast<char>('a' + rng() % 3);
+    auto type = static_cast<uint8_t>(rng() % 3);
+    directory.upsert(contact(last, phone, type));
+    model.by_phone[phone] = contact(last, phone, type);
+  }
+  ASSERT_EQ(model.by_phone.size(), directory.size());
+
+  for (const char * prefix : {"", "S", "Sm", "Smith", "Smytha", "Lin", "Li", "Brownin", "Zed"}) {
+    auto expected = model.prefix(prefix);
+    auto all = directory.last_name_prefix(prefix, 0);
+    EXPECT_EQ(expected.size(), all.total) << prefix;
+    ASSERT_EQ(expected.size(), all.contacts.size()) << prefix;
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i], all.contacts[i].last_name) << prefix;
+    }
+    auto limited = directory.last_name_prefix(prefix, 10);
+    EXPECT_EQ(expected.size(), limited.total) << prefix;
+    ASSERT_EQ(std::min<size_t>(10, expected.size()), limited.contacts.size()) << prefix;
+    for (size_t i = 0; i < limited.contacts.size(); ++i) {
+      EXPECT_EQ(expected[i], limited.contacts[i].last_name) << prefix;
+    }
+  }
+
+  for (uint8_t type = 0; type < 3; ++type) {
+    uint64_t expected = 0;
+    for (const auto & entry : model.by_phone) {
+      expected += entry.second.phone_type == type ? 1 : 0;
+    }
+    auto all = directory.phone_type(type, 0);
+    EXPECT_EQ(expected, all.total);
+    EXPECT_EQ(expected, all.contacts.size());
+    for (const auto & record : all.contacts) {
+      EXPECT_EQ(type, record.phone_type);
+    }
+    EXPECT_EQ(5u, directory.phone_type(type, 5).contacts.size());
+  }
+}
+
+TEST(ContactDirectory, renamed_contact_leaves_old_prefix)
+{
+  ContactDirectory directory(small_options());
+  for (int i = 0; i < 100; ++i) {
+    directory.upsert(contact("Old" + std::to_string(i), std::to_string(i), 0));
+  }
+  directory.upsert(contact("New", "7", 0));
+  EXPECT_EQ(99u, directory.last_name_prefix("Old", 0).total);
+  auto old7 = directory.last_name_prefix("Old7", 0);  // Old70 .. Old79, no longer Old7 itself
+  EXPECT_EQ(10u, old7.total);
+  for (const auto & record : old7.contacts) {
+    EXPECT_NE("7", record.phone_number);
+  }
+  auto renamed = directory.last_name_prefix("New", 0);
+  ASSERT_EQ(1u, renamed.contacts.size());
+  EXPECT_EQ("7", renamed.contacts[0].phone_number);
+}
+
+TEST(ContactDirectory, count_bytes_matches_naive_count)
+{
+  std::mt19937 rng(3);
+  std::vector<uint8_t> data(1003);
+  for (auto & byte : data) {
+    byte = static_cast<uint8_t>(rng() % 4 == 0 ? 0x80 : rng());
+  }
+  for (int value : {0x00, 0x01, 0x7f, 0x80, 0xff}) {
+    for (size_t n : {size_t{0}, size_t{7}, size_t{8}, size_t{1003}}) {
+      size_t expected = static_cast<size_t>(std::count(data.begin(), data.begin() + n, value));
+      EXPECT_EQ(expected, ContactDirectory::count_bytes(data.data(), n, static_cast<uint8_t>(value)))
+        << value << " " << n;
+    }
+  }
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "tutorial_utils/perf_gate.hpp"
+
+using tutorial_utils::PerfBaseline;
+using tutorial_utils::PerfBaselineEntry;
+using tutorial_utils::PerfResult;
+using tutorial_utils::PerfThresholds;
+
+namespace
+{
+
+PerfResult result(double median, double mad)
+{
+  PerfResult r;
+  r.name = "bench";
+  r.median_ns = median;
+  r.mad_ns = mad;
+  r.repetitions = 15;
+  return r;
+}
+
+}  // namespace
+
+TEST(PerfGate, median_and_mad)
+{
+  EXPECT_DOUBLE_EQ(3.0, tutorial_utils::median_of({5.0, 1.0, 3.0}));
+  EXPECT_DOUBLE_EQ(2.5, tutorial_utils::median_of({4.0, 1.0, 2.0, 3.0}));
+  // deviations from 3: {2, 2, 0, 1, 97} -> 2
+  EXPECT_DOUBLE_EQ(2.0, tutorial_utils::mad_of({1.0, 5.0, 3.0, 4.0, 100.0}, 3.0));
+}
+
+TEST(PerfGate, regression_needs_significance_and_size)
+{
+  PerfThresholds thresholds;
+  PerfBaselineEntry base{100.0, 1.0, 15};
+  // 20% slower and far outside the noise
+  auto slow = tutorial_utils::compare_to_baseline(base, result(120.0, 1.0), thresholds);
+  EXPECT_TRUE(slow.compared);
+  EXPECT_TRUE(slow.regression);
+  // 20% slower but within the noise of a jittery benchmark
+  EXPECT_FALSE(tutorial_utils::compare_to_baseline(base, result(120.0, 10.0), thresholds).regression);
+  // significant but below the 10% floor
+  EXPECT_FALSE(tutorial_utils::compare_to_baseline(base, result(105.0, 0.1), thresholds).regression);
+  // faster is never a regression
+  EXPECT_FALSE(tutorial_utils::compare_to_baseline(base, result(50.0, 0.1), thresholds).regression);
+  // no baseline value
+  EXPECT_FALSE(tutorial_utils::compare_to_baseline(PerfBaselineEntry(), result(120.0, 1.0), thresholds).compared);
+}
+
+TEST(PerfGate, baseline_round_trip)
+{
+  PerfBaseline out;
+  out.host = "box | CPU \"X\" | 8 cpus";
+  out.benchmarks["a"] = PerfBaselineEntry{12.5, 0.25, 15};
+  out.benchmarks["b_round_trip"] = PerfBaselineEntry{48000.0, 900.0, 9};
+  std::string path = testing::TempDir() + "perf_gate_baseline.json";
+  std::string error;
+  ASSERT_TRUE(out.save(path, error)) << error;
+
+  PerfBaseline in;
+  ASSERT_TRUE(in.load(path, error)) << error;
+  EXPECT_EQ(out.host, in.host);
+  ASSERT_EQ(2u, in.benchmarks.size());
+  EXPECT_DOUBLE_EQ(12.5, in.benchmarks["a"].median_ns);
+  EXPECT_DOUBLE_EQ(0.25, in.benchmarks["a"].mad_ns);
+  EXPECT_EQ(9u, in.benchmarks["b_round_trip"].repetitions);
+  std::remove(path.c_str());
+}
+
+TEST(PerfGate, baseline_rejects_malformed_and_ignores_unknown_fields)
+{
+  std::string path = testing::TempDir() + "perf_gate_malformed.json";
+  std::string error;
+  PerfBaseline in;
+  {
+    FILE * f = std::fopen(path.c_str(), "w");
+    std::fputs("{\"host\": \"h\", \"note\": {\"x\": 1}, \"benchmarks\": {\"a\": {\"median_ns\": 2, \"unit\": \"ns\"}}}", f);
+    std::fclose(f);
+  }
+  ASSERT_TRUE(in.load(path, error)) << error;
+  EXPECT_DOUBLE_EQ(2.0, in.benchmarks["a"].median_ns);
+  {
+    FILE * f = std::fopen(path.c_str(), "w");
+    std::fputs("{\"host\": \"h\", \"benchmarks\": {\"a\": ", f);
+    std::fclose(f);
+  }
+  EXPECT_FALSE(in.load(path, error));
+  std::remove(path.c_str());
+}
+
+TEST(PerfGate, run_benchmark_calibrates_iterations)
+{
+  tutorial_utils::PerfOptions options;
+  options.repetitions = 5;
+  options.min_repetition_ms = 1.0;
+  options.warmup = 0;
+  volatile uint64_t sink = 0;
+  auto r = tutorial_utils::run_benchmark(
+    "loop", [&sink](uint64_t n) {
+      for (uint64_t i = 0; i < n; ++i) {
+        sink = sink + i;
+      }
+    }, options);
+  EXPECT_EQ("loop", r.name);
+  EXPECT_EQ(5u, r.repetitions);
+  EXPECT_GT(r.iterations, 1u);
+  EXPECT_GT(r.median_ns, 0.0);
+}
+
+TEST(PerfGate, host_fingerprint_is_the_cpu_or_the_override)
+{
+  unsetenv("PERF_GATE_HOST");
+  auto fingerprint = tutorial_utils::host_fingerprint();
+  EXPECT_NE(std::string::npos, fingerprint.find(" cpus")) << fingerprint;
+  EXPECT_EQ(1, std::count(fingerprint.begin(), fingerprint.end(), '|')) << fingerprint;
+  setenv("PERF_GATE_HOST", "ci-runner-a", 1);
+  EXPECT_EQ("ci-runner-a", tutorial_utils::host_fingerprint());
+  unsetenv("PERF_GATE_HOST");
+}
+
+TEST(PerfGate, check_fails_without_a_baseline_for_this_host)
+{
+  unsetenv("PERF_GATE_UPDATE");
+  unsetenv("PERF_GATE_DISABLE");
+  std::string path = testing::TempDir() + "perf_gate_hosts.json";
+  PerfBaseline recorded;
+  recorded.host = "ci-runner-a";
+  recorded.benchmarks["bench"] = PerfBaselineEntry{100.0, 1.0, 15};
+  std::string error;
+  ASSERT_TRUE(recorded.save(path, error)) << error;
+
+  setenv("PERF_GATE_HOST", "ci-runner-b", 1);
+  {
+    tutorial_utils::PerfGate gate(path);
+    auto verdict = gate.check(result(100.0, 1.0));
+    EXPECT_TRUE(verdict.missing_baseline);
+    EXPECT_FALSE(verdict.passed());
+  }
+  setenv("PERF_GATE_HOST", "ci-runner-a", 1);
+  {
+    tutorial_utils::PerfGate gate(path);
+    auto same = gate.check(result(101.0, 1.0));
+    EXPECT_TRUE(same.compared);
+    EXPECT_TRUE(same.passed()) << same.message;
+    auto slow = gate.check(result(150.0, 1.0));
+    EXPECT_FALSE(slow.passed()) << slow.message;
+    auto unknown = result(100.0, 1.0);
+    unknown.name = "not_recorded";
+    EXPECT_FALSE(gate.check(unknown).passed());
+  }
+  unsetenv("PERF_GATE_HOST");
+  std::remove(path.c_str());
+}
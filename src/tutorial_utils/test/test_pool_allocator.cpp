@@ -0,0 +1,363 @@
+// Allocation-tracking tests for the pool allocator.
+// Global operator new/delete and malloc/calloc/realloc/free (glibc) are replaced in this binary
+// and counted while the calling thread has tracking on, so a steady-state loop can assert that it
+// never reached the global heap, including through the rcutils C allocator used by rcl/rmw.
+// Only the thread running the loop is tracked: middleware threads (discovery, receive) allocate
+// on their own schedule and are not part of what the pool claims to serve.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "std_msgs/msg/u_int32.hpp"
+#include "tutorial_utils/pool_memory_strategy.hpp"
+
+namespace
+{
+thread_local bool g_tracking = false;
+std::atomic<uint64_t> g_global_news{0};
+std::atomic<uint64_t> g_global_deletes{0};
+std::atomic<uint64_t> g_mallocs{0};  // malloc, calloc and realloc
+std::atomic<uint64_t> g_frees{0};
+
+struct TrackGlobalHeap
+{
+  TrackGlobalHeap()
+  {
+    g_global_news = 0;
+    g_global_deletes = 0;
+    g_mallocs = 0;
+    g_frees = 0;
+    g_tracking = true;
+  }
+  ~TrackGlobalHeap()
+  {
+    g_tracking = false;
+  }
+};
+}  // namespace
+
+extern "C" {
+void * __libc_malloc(std::size_t size);
+void * __libc_calloc(std::size_t count, std::size_t size);
+void * __libc_realloc(void * p, std::size_t size);
+void __libc_free(void * p);
+
+void * malloc(std::size_t size)
+{
+  if (g_tracking) {
+    ++g_mallocs;
+  }
+  return __libc_malloc(size);
+}
+
+void * calloc(std::size_t count, std::size_t size)
+{
+  if (g_tracking) {
+    ++g_mallocs;
+  }
+  return __libc_calloc(count, size);
+}
+
+void * realloc(void * p, std::size_t size)
+{
+  if (g_tracking) {
+    ++g_mallocs;
+  }
+  return __libc_realloc(p, size);
+}
+
+void free(void * p)
+{
+  if (g_tracking && p != nullptr) {
+    ++g_frees;
+  }
+  __libc_free(p);
+}
+}  // extern "C"
+
+// counted separately from malloc, so the allocation goes to glibc directly
+void * operator new(std::size_t size)
+{
+  if (g_tracking) {
+    ++g_global_news;
+  }
+  void * p = __libc_malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void * p) noexcept
+{
+  if (g_tracking && p != nullptr) {
+    ++g_global_deletes;
+  }
+  __libc_free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept
+{
+  operator delete(p);
+}
+
+using tutorial_utils::PoolAllocator;
+using tutorial_utils::PoolResource;
+
+TEST(PoolResource, size_classes)
+{
+  EXPECT_EQ(0u, PoolResource::size_class(1));
+  EXPECT_EQ(0u, PoolResource::size_class(16));
+  EXPECT_EQ(1u, PoolResource::size_class(17));
+  EXPECT_EQ(PoolResource::kNumClasses - 1, PoolResource::size_class(64 * 1024));
+  EXPECT_EQ(PoolResource::kNumClasses, PoolResource::size_class(64 * 1024 + 1));
+}
+
+TEST(PoolResource, falls_back_before_reserve_and_when_too_large)
+{
+  PoolResource pool;
+  void * p = pool.allocate(32);
+  EXPECT_FALSE(pool.owns(p));
+  pool.deallocate(p, 32);
+  ASSERT_TRUE(pool.reserve(1024 * 1024));
+  EXPECT_FALSE(pool.reserve(1024 * 1024));
+
+  void * big = pool.allocate(128 * 1024);
+  EXPECT_FALSE(pool.owns(big));
+  pool.deallocate(big, 128 * 1024);
+
+  auto stats = pool.stats();
+  EXPECT_EQ(0u, stats.pool_allocations);
+  EXPECT_EQ(2u, stats.fallback_allocations);
+  EXPECT_EQ(2u, stats.fallback_deallocations);
+}
+
+TEST(PoolResource, recycles_blocks)
+{
+  PoolResource pool(1024 * 1024);
+  void * a = pool.allocate(100);
+  ASSERT_TRUE(pool.owns(a));
+  pool.deallocate(a, 100);
+  void * b = pool.allocate(120);  // same 128 B class
+  EXPECT_EQ(a, b);
+  pool.deallocate(b, 120);
+
+  auto stats = pool.stats();
+  EXPECT_EQ(2u, stats.pool_allocations);
+  EXPECT_EQ(2u, stats.pool_deallocations);
+  EXPECT_EQ(0u, stats.fallback_allocations);
+  EXPECT_EQ(128u, stats.arena_used);
+}
+
+TEST(PoolResource, exhausted_arena_falls_back)
+{
+  PoolResource pool(64);
+  void * a = pool.allocate(64);
+  void * b = pool.allocate(64);
+  EXPECT_TRUE(pool.owns(a));
+  EXPECT_FALSE(pool.owns(b));
+  pool.deallocate(a, 64);
+  pool.deallocate(b, 64);
+  EXPECT_EQ(1u, pool.stats().fallback_allocations);
+}
+
+TEST(PoolAllocator, std_containers_steady_state_without_global_heap)
+{
+  tutorial_utils::default_pool().reserve(16 * 1024 * 1024);
+  std::vector<int, PoolAllocator<int>> v;
+  std::list<int, PoolAllocator<int>> l;
+  // warm up: grow to the steady-state sizes once
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(i);
+    l.push_back(i);
+  }
+  l.clear();
+
+  TrackGlobalHeap track;
+  for (int round = 0; round < 100; ++round) {
+    v.clear();
+    for (int i = 0; i < 1000; ++i) {
+      v.push_back(i);
+      l.push_back(i);
+    }
+    l.clear();
+  }
+  EXPECT_EQ(0u, g_global_news.load());
+  EXPECT_EQ(0u, g_global_deletes.load());
+  EXPECT_EQ(0u, g_mallocs.load());
+  EXPECT_EQ(0u, g_frees.load());
+}
+
+// Intra-process publish/subscribe of a fixed-size message with pool-backed publisher,
+// subscription and executor memory strategy: after warm-up, message flow performs no global
+// operator new/delete and no malloc (the executor's rcl wait set is sized through the memory
+// strategy's allocator, i.e. the pool).
+TEST(PoolAllocator, intra_process_message_flow_without_global_heap)
+{
+  using MessageT = std_msgs::msg::UInt32;
+  using Alloc = tutorial_utils::PoolAlloc;
+  using MessageAllocTraits = rclcpp::allocator::AllocRebind<MessageT, Alloc>;
+  using MessageAlloc = MessageAllocTraits::allocator_type;
+  using MessageDeleter = rclcpp::allocator::Deleter<MessageAlloc, MessageT>;
+  using MessageUniquePtr = std::unique_ptr<MessageT, MessageDeleter>;
+
+  rclcpp::init(0, nullptr);
+  tutorial_utils::default_pool().reserve(16 * 1024 * 1024);
+  {
+    auto node = std::make_shared<rclcpp::Node>(
+      "pool_allocator_test", rclcpp::NodeOptions().use_intra_process_comms(true));
+
+    uint32_t received = 0;
+    uint32_t last = 0;
+    // take ownership so intra-process hands over the pointer instead of promoting it to a
+    // shared_ptr (which would allocate a control block on the global heap)
+    auto subscription = node->create_subscription<MessageT>(
+      "pool_allocator_test", 10,
+      [&received, &last](MessageUniquePtr msg) {
+        ++received;
+        last = msg->data;
+      },
+      tutorial_utils::pool_subscription_options());
+    auto publisher = node->create_publisher<MessageT>(
+      "pool_allocator_test", 10, tutorial_utils::pool_publisher_options());
+
+    rclcpp::executors::SingleThreadedExecutor executor(tutorial_utils::pool_executor_options());
+    executor.add_node(node);
+
+    MessageAlloc message_alloc;
+    auto publish = [&](uint32_t value) {
+        auto ptr = MessageAllocTraits::allocate(message_alloc, 1);
+        MessageAllocTraits::construct(message_alloc, ptr);
+        MessageDeleter deleter;
+        rclcpp::allocator::set_allocator_for_deleter(&deleter, &message_alloc);
+        MessageUniquePtr msg(ptr, deleter);
+        msg->data = value;
+        publisher->publish(std::move(msg));
+        executor.spin_some();
+      };
+
+    // warm up: first messages size the executor vectors and intra-process buffers
+    for (uint32_t i = 0; i < 100; ++i) {
+      publish(i);
+    }
+    ASSERT_EQ(100u, received);
+
+    auto before = tutorial_utils::default_pool().stats();
+    {
+      TrackGlobalHeap track;
+      for (uint32_t i = 100; i < 1100; ++i) {
+        publish(i);
+      }
+    }
+    auto after = tutorial_utils::default_pool().stats();
+
+    EXPECT_EQ(1100u, received);
+    EXPECT_EQ(1099u, last);
+    EXPECT_EQ(0u, g_global_news.load());
+    EXPECT_EQ(0u, g_global_deletes.load());
+    EXPECT_EQ(0u, g_mallocs.load());
+    EXPECT_EQ(0u, g_frees.load());
+    EXPECT_GE(after.pool_allocations - before.pool_allocations, 1000u);
+    EXPECT_EQ(before.fallback_allocations, after.fallback_allocations);
+  }
+  rclcpp::shutdown();
+}
+
+// The talker -> listener path as the opted-in nodes run it: std_msgs::msg::String through the
+// middleware (no intra-process), pool-backed publisher, subscription and executor, and the
+// talker's message reused between publishes. The pool serves the message objects the listener
+// takes into and the executor's bookkeeping, but the string field is deserialized with
+// std::allocator and rmw allocates for itself, so this path is not free of the global heap.
+// The test checks what the pool does serve and reports the remaining heap calls per message.
+TEST(PoolAllocator, string_talker_listener_flow_takes_messages_from_pool)
+{
+  rclcpp::init(0, nullptr);
+  tutorial_utils::default_pool().reserve(16 * 1024 * 1024);
+  {
+    auto talker = std::make_shared<rclcpp::Node>("pool_allocator_talker");
+    auto listener = std::make_shared<rclcpp::Node>("pool_allocator_listener");
+    uint64_t received = 0;
+    auto subscription = listener->create_subscription<std_msgs::msg::String>(
+      "pool_allocator_chatter", 10,
+      [&received](const std_msgs::msg::String::SharedPtr, const rclcpp::MessageInfo &) {
+        ++received;
+      },
+      tutorial_utils::pool_subscription_options());
+    auto publisher = talker->create_publisher<std_msgs::msg::String>(
+      "pool_allocator_chatter", 10, tutorial_utils::pool_publisher_options());
+
+    rclcpp::executors::SingleThreadedExecutor executor(tutorial_utils::pool_executor_options());
+    executor.add_node(talker);
+    executor.add_node(listener);
+
+    // longer than the small-string buffer, like the talker's "Hello, world! ..." messages
+    std_msgs::msg::String msg;
+    msg.data = "Hello, world! 0000000000";
+    uint64_t sent = 0;
+    auto publish = [&]() {
+        // rewrite the counter in place: the reused message never reallocates
+        uint64_t n = sent++;
+        for (size_t i = msg.data.size(); i-- > msg.data.size() - 10; n /= 10) {
+          msg.data[i] = static_cast<char>('0' + n % 10);
+        }
+        publisher->publish(msg);
+      };
+    auto spin_until_received = [&](uint64_t count) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (received < count && std::chrono::steady_clock::now() < deadline) {
+          executor.spin_some();
+        }
+        return received >= count;
+      };
+
+    // warm up: discovery, then enough messages to size the executor and middleware buffers
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received == 0 && std::chrono::steady_clock::now() < deadline) {
+      publish();
+      executor.spin_some(std::chrono::milliseconds(10));
+    }
+    ASSERT_GT(received, 0u) << "listener never matched the talker";
+    for (int i = 0; i < 100; ++i) {
+      publish();
+      ASSERT_TRUE(spin_until_received(received + 1));
+    }
+
+    const uint64_t kMessages = 1000;
+    uint64_t first = received;
+    auto before = tutorial_utils::default_pool().stats();
+    bool all_received = true;
+    uint64_t news = 0;
+    uint64_t mallocs = 0;
+    {
+      TrackGlobalHeap track;
+      for (uint64_t i = 0; i < kMessages && all_received; ++i) {
+        publish();
+        all_received = spin_until_received(first + i + 1);
+      }
+      news = g_global_news.load();
+      mallocs = g_mallocs.load();
+    }
+    auto after = tutorial_utils::default_pool().stats();
+
+    ASSERT_TRUE(all_received);
+    // every message the listener took was borrowed from the pool, none fell back to the heap
+    EXPECT_GE(after.pool_allocations - before.pool_allocations, kMessages);
+    EXPECT_EQ(before.fallback_allocations, after.fallback_allocations);
+    std::printf(
+      "string talker -> listener, per message: %.2f operator new, %.2f malloc/calloc/realloc\n",
+      static_cast<double>(news) / kMessages, static_cast<double>(mallocs) / kMessages);
+    RecordProperty("global_new_per_1000_messages", static_cast<int>(news));
+    RecordProperty("malloc_per_1000_messages", static_cast<int>(mallocs));
+  }
+  rclcpp::shutdown();
+}
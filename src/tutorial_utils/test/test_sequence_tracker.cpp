@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "tutorial_utils/sequence_tracker.hpp"
+
+using tutorial_utils::SequenceTracker;
+using Result = SequenceTracker::Result;
+
+TEST(SequenceTracker, in_order)
+{
+  SequenceTracker t;
+  EXPECT_EQ(Result::First, t.on_message(5));
+  for (uint64_t s = 6; s < 100; ++s) {
+    EXPECT_EQ(Result::InOrder, t.on_message(s));
+  }
+  EXPECT_EQ(95u, t.counters().received);
+  EXPECT_EQ(0u, t.counters().lost);
+  EXPECT_EQ(99u, t.counters().highest);
+}
+
+TEST(SequenceTracker, gap_then_late_arrival)
+{
+  SequenceTracker t;
+  t.on_message(0);
+  EXPECT_EQ(Result::Gap, t.on_message(4));
+  EXPECT_EQ(3u, t.counters().lost);
+  EXPECT_EQ(Result::Reordered, t.on_message(2));
+  EXPECT_EQ(2u, t.counters().lost);
+  EXPECT_EQ(1u, t.counters().reordered);
+  EXPECT_EQ(Result::Duplicate, t.on_message(2));
+  EXPECT_EQ(Result::Duplicate, t.on_message(4));
+  EXPECT_EQ(2u, t.counters().duplicates);
+  EXPECT_EQ(3u, t.counters().received);
+}
+
+TEST(SequenceTracker, restart_far_behind_resets)
+{
+  SequenceTracker t;
+  t.on_message(100000);
+  EXPECT_EQ(Result::Reset, t.on_message(0));
+  EXPECT_EQ(Result::InOrder, t.on_message(1));
+  EXPECT_EQ(1u, t.counters().resets);
+  EXPECT_EQ(0u, t.counters().lost);
+}
+
+TEST(SequenceTracker, late_sample_from_before_start_is_not_a_recovered_loss)
+{
+  SequenceTracker t;
+  t.on_message(100);
+  EXPECT_EQ(Result::Reordered, t.on_message(99));
+  EXPECT_EQ(0u, t.counters().lost);
+  EXPECT_EQ(Result::Duplicate, t.on_message(99));
+
+  // same after a reset: 2 lost after restarting at 10, 7 predates the restart
+  t.on_message(100000);
+  EXPECT_EQ(Result::Reset, t.on_message(10));
+  uint64_t lost = t.counters().lost;
+  t.on_message(13);
+  EXPECT_EQ(lost + 2, t.counters().lost);
+  EXPECT_EQ(Result::Reordered, t.on_message(7));
+  EXPECT_EQ(lost + 2, t.counters().lost);
+  EXPECT_EQ(Result::Reordered, t.on_message(12));
+  EXPECT_EQ(lost + 1, t.counters().lost);
+}
+
+TEST(SequenceTracker, large_jump_clears_window)
+{
+  SequenceTracker t;
+  t.on_message(0);
+  t.on_message(1);
+  t.on_message(1 + SequenceTracker::kReorderWindow + 10);
+  // 1 is now outside the window: treated as a restart, not as a duplicate
+  EXPECT_EQ(Result::Reset, t.on_message(1));
+}
+
+TEST(SequenceTracker, windowed_loss_histogram)
+{
+  SequenceTracker t;
+  for (uint64_t s = 0; s < 1000; ++s) {
+    t.on_message(s);
+  }
+  EXPECT_DOUBLE_EQ(0.0, t.close_window());
+
+  // 1000 expected, 20 lost -> 2 %
+  for (uint64_t s = 1000; s < 2000; ++s) {
+    if (s % 50 != 0) {
+      t.on_message(s);
+    }
+  }
+  EXPECT_NEAR(0.02, t.close_window(), 1e-9);
+
+  EXPECT_DOUBLE_EQ(0.0, t.close_window());  // empty window is not recorded
+
+  const auto & h = t.histogram();
+  EXPECT_EQ(1u, h[0]);
+  EXPECT_EQ(1u, h[SequenceTracker::bucket(0.02)]);
+  EXPECT_EQ(3u, SequenceTracker::bucket(0.02));
+  EXPECT_EQ(SequenceTracker::kNumBuckets - 1, SequenceTracker::bucket(0.5));
+}
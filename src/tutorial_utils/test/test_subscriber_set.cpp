@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+#include "std_msgs/msg/u_int32.hpp"
+#include "tutorial_utils/subscriber_set.hpp"
+
+using std_msgs::msg::String;
+using std_msgs::msg::UInt32;
+using tutorial_utils::HandlerKind;
+using tutorial_utils::handler_kind;
+using tutorial_utils::on;
+
+namespace
+{
+
+class SubscriberSetTest : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase() {rclcpp::init(0, nullptr);}
+  static void TearDownTestCase() {rclcpp::shutdown();}
+};
+
+// spin (or poll) until done() or a 5 s timeout
+template<typename Step, typename Done>
+bool wait_until(Step step, Done done)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done() && std::chrono::steady_clock::now() < deadline) {
+    step();
+  }
+  return done();
+}
+
+}  // namespace
+
+TEST(HandlerKind, picks_the_cheapest_signature)
+{
+  auto ref = [](const String &) {};
+  auto ref_info = [](const String &, const rclcpp::MessageInfo &) {};
+  auto unique = [](std::unique_ptr<String>) {};
+  auto wrong_type = [](const UInt32 &) {};
+  static_assert(handler_kind<decltype(ref), String>::value == HandlerKind::Ref, "");
+  static_assert(handler_kind<decltype(ref_info), String>::value == HandlerKind::RefWithInfo, "");
+  static_assert(handler_kind<decltype(unique), String>::value == HandlerKind::Unique, "");
+  static_assert(handler_kind<decltype(wrong_type), String>::value == HandlerKind::Invalid, "");
+}
+
+TEST_F(SubscriberSetTest, dispatch_routes_by_type_without_copying)
+{
+  auto node = std::make_shared<rclcpp::Node>("subscriber_set_dispatch");
+  const String * seen = nullptr;
+  uint32_t sum = 0;
+  std::unique_ptr<String> owned;
+  auto set = tutorial_utils::make_subscriber_set(
+    *node, rclcpp::QoS(10),
+    on<String>("set_a", [&seen](const String & msg) {seen = &msg;}),
+    on<UInt32>("set_b", [&sum](const UInt32 & msg, const rclcpp::MessageInfo &) {sum += msg.data;}),
+    on<String>("set_c", [&owned](std::unique_ptr<String> msg) {owned = std::move(msg);}));
+  EXPECT_EQ(3u, set->size());
+
+  String text;
+  text.data = "hello";
+  set->dispatch(text);
+  EXPECT_EQ(&text, seen);
+
+  UInt32 value;
+  value.data = 7;
+  set->dispatch(value);
+  set->dispatch<1>(value);
+  EXPECT_EQ(14u, sum);
+
+  set->dispatch<2>(text);
+  ASSERT_NE(nullptr, owned);
+  EXPECT_EQ("hello", owned->data);
+  EXPECT_NE(&text, owned.get());
+}
+
+TEST_F(SubscriberSetTest, executor_delivers_to_every_entry)
+{
+  auto node = std::make_shared<rclcpp::Node>("subscriber_set_executor");
+  std::string text;
+  uint32_t sum = 0;
+  auto set = tutorial_utils::make_subscriber_set(
+    *node, rclcpp::QoS(10),
+    on<String>("set_exec_a", [&text](const String & msg) {text += msg.data;}),
+    on<UInt32>("set_exec_b", [&sum](std::unique_ptr<UInt32> msg) {sum += msg->data;}));
+  auto pub_a = node->create_publisher<String>("set_exec_a", 10);
+  auto pub_b = node->create_publisher<UInt32>("set_exec_b", 10);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  String a;
+  a.data = "x";
+  UInt32 b;
+  b.data = 3;
+  EXPECT_TRUE(
+    wait_until(
+      [&]() {
+        pub_a->publish(a);
+        pub_b->publish(b);
+        executor.spin_some(std::chrono::milliseconds(10));
+      },
+      [&]() {return !text.empty() && sum > 0;}));
+}
+
+TEST_F(SubscriberSetTest, take_all_without_executor)
+{
+  // the set's node is never added to an executor: messages are only taken by take_all()
+  auto node = std::make_shared<rclcpp::Node>("subscriber_set_take");
+  uint32_t received = 0;
+  uint32_t last = 0;
+  auto set = tutorial_utils::make_subscriber_set(
+    *node, rclcpp::QoS(100),
+    on<UInt32>("set_take", [&](const UInt32 & msg) {++received; last = msg.data;}));
+  auto publisher = node->create_publisher<UInt32>("set_take", 100);
+
+  rclcpp::WaitSet wait_set;
+  set->add_to(wait_set);
+  uint32_t next = 0;
+  EXPECT_TRUE(
+    wait_until(
+      [&]() {
+        UInt32 msg;
+        msg.data = ++next;
+        publisher->publish(msg);
+        if (wait_set.wait(std::chrono::milliseconds(10)).kind() == rclcpp::WaitResultKind::Ready) {
+          set->take_all();
+        }
+      },
+      [&]() {return received >= 10;}));
+  EXPECT_LE(last, next);
+  EXPECT_GT(last, 0u);
+}
+
+TEST_F(SubscriberSetTest, take_all_hands_unique_handlers_the_taken_message)
+{
+  auto node = std::make_shared<rclcpp::Node>("subscriber_set_take_unique");
+  std::vector<std::unique_ptr<String>> owned;
+  auto set = tutorial_utils::make_subscriber_set(
+    *node, rclcpp::QoS(100),
+    on<String>("set_take_unique", [&owned](std::unique_ptr<String> msg) {owned.push_back(std::move(msg));}));
+  // no reusable scratch message for a unique_ptr entry: take() deserializes straight into the
+  // message the handler receives, there is nothing to copy from
+  using Set = std::remove_reference_t<decltype(*set)>;
+  static_assert(std::is_same<Set::scratch_t<0>, tutorial_utils::detail::NoScratch>::value, "");
+  auto publisher = node->create_publisher<String>("set_take_unique", 100);
+
+  rclcpp::WaitSet wait_set;
+  set->add_to(wait_set);
+  EXPECT_TRUE(
+    wait_until(
+      [&]() {
+        String msg;
+        msg.data = std::string(4096, 'u');
+        publisher->publish(msg);
+        if (wait_set.wait(std::chrono::milliseconds(10)).kind() == rclcpp::WaitResultKind::Ready) {
+          set->take_all();
+        }
+      },
+      [&]() {return owned.size() >= 3;}));
+  for (const auto & msg : owned) {
+    ASSERT_NE(nullptr, msg);
+    EXPECT_EQ(4096u, msg->data.size());
+  }
+  EXPECT_NE(owned[0].get(), owned[1].get());
+}